@@ -0,0 +1,69 @@
+// Measures how fast a large generated program is loaded, from the file on disk to the tokens of every line
+// The program is a lookup table filled element by element followed by unrolled comparisons, like machine written scripts
+// The size in MB is the first argument and 500 by default
+
+#include <chrono>
+
+// The interpreter is a single translation unit, its main is renamed so that this file can have its own
+#define main symlsMain
+#include "../src/symls.cpp"
+#undef main
+
+// Write about megabytes MB of program to the file
+void generate(string fileName, long long megabytes)
+{
+    ofstream script(fileName);
+    long long target = megabytes * 1000000, written = 0;
+    script << "let integer-array table-1024" << endl;
+    script << "let integer x is 0 and let integer y is 0" << endl;
+    string line;
+    for (long long i = 0; written < target; i++)
+    {
+        if (i % 4 == 0)
+        {
+            line = "if x is equal-to " + to_string(i % 1000) + " then y is y plus " + to_string(i % 97) + " else stop";
+        }
+        else if (i % 4 == 1)
+        {
+            line = "leave entry " + to_string(i);
+        }
+        else
+        {
+            // Chained lines end with and
+            line = "table-" + to_string(i % 1024) + " is " + to_string(i % 100000) + (i % 4 == 2 ? " and" : "");
+        }
+        script << line << '\n';
+        written += line.size() + 1;
+    }
+    script << "print y" << endl;
+    script << "end" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    long long megabytes = argc > 1 ? atoll(argv[1]) : 500;
+    string fileName = "load_benchmark.symls";
+    generate(fileName, megabytes);
+
+    SourceFile file;
+    openSource(fileName, file);
+    double size = file.size / 1000000.0;
+    closeSource(file);
+
+    auto start = chrono::steady_clock::now();
+    vector<SourceLine> lines;
+    preprocess(fileName, lines);
+    auto end = chrono::steady_clock::now();
+    double seconds = chrono::duration<double>(end - start).count();
+
+    long long tokens = 0;
+    for (auto &line : lines)
+    {
+        tokens += line.tokens.size();
+    }
+    printf("%.1f MB, %zu lines, %lld tokens\n", size, lines.size(), tokens);
+    printf("Loaded in %.2f s, %.1f MB/s\n", seconds, size / seconds);
+
+    remove(fileName.c_str());
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Compares the integer power kernel with the loop of one multiplication per exponent it replaced
+// For exponents from 10 to 1000000000 it measures a base which needs the full kernel and bases with a fast path
+
+#include <chrono>
+
+// The interpreter is a single translation unit, its main is renamed so that this file can have its own
+#define main symlsMain
+#include "../src/symls.cpp"
+#undef main
+
+// Nanoseconds per operation of f which does count operations
+template <typename F>
+double measure(long long count, F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / count;
+}
+
+// Defeats the optimizer throwing away the powers
+volatile int sink;
+
+// The previous power, unsigned so that it wraps around like the kernel does
+int loopPower(int number, int exponent)
+{
+    unsigned int result = 1;
+    for (int i = 0; i < exponent; i++)
+    {
+        result *= number;
+    }
+    return (int)result;
+}
+
+void benchmark(int number, int exponent)
+{
+    // The loop runs about the same number of multiplications for every exponent
+    long long calls = min(10000000LL, max(1LL, 2000000000LL / exponent));
+    long long kernelCalls = 10000000;
+
+    // The base comes from a volatile so that the power is not solved while compiling
+    volatile int base = number;
+    double loop = measure(calls, [&]()
+                          {
+        int sum = 0;
+        for (long long i = 0; i < calls; i++)
+        {
+            sum += loopPower(base, exponent);
+        }
+        sink = sum; });
+    double kernel = measure(kernelCalls, [&]()
+                            {
+        int sum = 0;
+        for (long long i = 0; i < kernelCalls; i++)
+        {
+            sum += power(base, exponent);
+        }
+        sink = sum; });
+
+    if (loopPower(number, exponent) != power(number, exponent))
+    {
+        printf("%d exponent %d differs\n", number, exponent);
+    }
+    printf("%3d exponent %10d   %14.1f ns / %6.1f ns\n", number, exponent, loop, kernel);
+}
+
+int main()
+{
+    printf("Times are per power, loop / kernel\n");
+    for (int number : {3, 2, -1})
+    {
+        for (int exponent : {10, 1000, 1000000, 1000000000})
+        {
+            benchmark(number, exponent);
+        }
+    }
+    return 0;
+}
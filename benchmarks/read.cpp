@@ -0,0 +1,94 @@
+// Compares the buffered reader of read with the cin extraction it replaced
+// A file of whitespace separated integers and one of reals are read through stdin both ways
+// The count is the first argument and 1000000 by default
+
+#include <chrono>
+
+// The interpreter is a single translation unit, its main is renamed so that this file can have its own
+#define main symlsMain
+#include "../src/symls.cpp"
+#undef main
+
+// Seconds taken by f
+template <typename F>
+double measure(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+// Point stdin at the start of the file and forget what the reader has buffered
+void rewindInput(string fileName)
+{
+    freopen(fileName.c_str(), "r", stdin);
+    cin.clear();
+    inputStart = inputEnd = 0;
+    inputEnded = inputFailed = false;
+}
+
+int main(int argc, char *argv[])
+{
+    long long count = argc > 1 ? atoll(argv[1]) : 1000000;
+    string integersFile = "read_benchmark_integers.txt", realsFile = "read_benchmark_reals.txt";
+    {
+        ofstream integers(integersFile), reals(realsFile);
+        unsigned int seed = 12345;
+        for (long long i = 0; i < count; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            integers << (int)(seed >> 1) - (1 << 30) << (i % 10 == 9 ? '\n' : ' ');
+            reals << (seed % 2000000) / 1000.0 - 1000.0 << (i % 10 == 9 ? '\n' : ' ');
+        }
+    }
+
+    // Sums keep the values alive and check that both ways read the same values
+    long long cinSum = 0, bufferedSum = 0;
+    double cinRealSum = 0.0, bufferedRealSum = 0.0;
+
+    rewindInput(integersFile);
+    double cinIntegers = measure([&]() {
+        int value;
+        for (long long i = 0; i < count; i++)
+        {
+            cin >> value;
+            cinSum += value;
+        }
+    });
+    rewindInput(integersFile);
+    double bufferedIntegers = measure([&]() {
+        int value;
+        for (long long i = 0; i < count; i++)
+        {
+            inputInteger(value);
+            bufferedSum += value;
+        }
+    });
+    rewindInput(realsFile);
+    double cinReals = measure([&]() {
+        double value;
+        for (long long i = 0; i < count; i++)
+        {
+            cin >> value;
+            cinRealSum += value;
+        }
+    });
+    rewindInput(realsFile);
+    double bufferedReals = measure([&]() {
+        double value;
+        for (long long i = 0; i < count; i++)
+        {
+            inputReal(value);
+            bufferedRealSum += value;
+        }
+    });
+
+    printf("%lld values, sums %s\n", count, cinSum == bufferedSum && cinRealSum == bufferedRealSum ? "match" : "differ");
+    printf("integers  cin %.3f s  buffered %.3f s  %.1fx\n", cinIntegers, bufferedIntegers, cinIntegers / bufferedIntegers);
+    printf("reals     cin %.3f s  buffered %.3f s  %.1fx\n", cinReals, bufferedReals, cinReals / bufferedReals);
+
+    remove(integersFile.c_str());
+    remove(realsFile.c_str());
+    return 0;
+}
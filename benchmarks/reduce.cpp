@@ -0,0 +1,87 @@
+// Compares the scalar, SSE and AVX2 kernels of the array reductions
+// Every kernel reduces the same integers and reals many times, and their results have to be equal
+// The array size is the first argument and 1000000 by default
+
+#include <chrono>
+
+// The interpreter is a single translation unit, its main is renamed so that this file can have its own
+#define main symlsMain
+#include "../src/symls.cpp"
+#undef main
+
+// Seconds taken by f
+template <typename F>
+double measure(F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = argc > 1 ? atoll(argv[1]) : 1000000;
+    int rounds = 200;
+    vector<int> integers(size);
+    vector<double> reals(size);
+    unsigned int seed = 12345;
+    for (size_t i = 0; i < size; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        integers[i] = (int)(seed >> 1) - (1 << 30);
+        reals[i] = (seed % 2000000) / 1000.0 - 1000.0;
+    }
+
+    vector<pair<string, ReductionKernels>> tiers = {{"scalar", kernels}};
+#ifdef SYMLS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        tiers.push_back({"sse", {sumIntegersSse, minimumIntegerSse, maximumIntegerSse, sumRealsSse, minimumRealSse, maximumRealSse}});
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        tiers.push_back({"avx2", {sumIntegersAvx2, minimumIntegerAvx2, maximumIntegerAvx2, sumRealsAvx2, minimumRealAvx2, maximumRealAvx2}});
+    }
+#endif
+
+    // The results of the first tier are the ones the others have to give
+    long long expected[6];
+    double scalarSeconds[2] = {1, 1};
+    printf("%zu elements, %d rounds\n", size, rounds);
+    for (size_t tier = 0; tier < tiers.size(); tier++)
+    {
+        ReductionKernels &k = tiers[tier].second;
+        long long results[6] = {0, 0, 0, 0, 0, 0};
+        double integerSeconds = measure([&]() {
+            for (int round = 0; round < rounds; round++)
+            {
+                results[0] += k.sumIntegers(integers.data(), size);
+                results[1] += k.minimumInteger(integers.data(), size);
+                results[2] += k.maximumInteger(integers.data(), size);
+            }
+        });
+        double realSeconds = measure([&]() {
+            double sum = 0.0, minimum = 0.0, maximum = 0.0;
+            for (int round = 0; round < rounds; round++)
+            {
+                sum = k.sumReals(reals.data(), size);
+                minimum = k.minimumReal(reals.data(), size);
+                maximum = k.maximumReal(reals.data(), size);
+            }
+            memcpy(&results[3], &sum, sizeof(double));
+            memcpy(&results[4], &minimum, sizeof(double));
+            memcpy(&results[5], &maximum, sizeof(double));
+        });
+        if (tier == 0)
+        {
+            memcpy(expected, results, sizeof(results));
+            scalarSeconds[0] = integerSeconds;
+            scalarSeconds[1] = realSeconds;
+        }
+        printf("%-7s integers %.3f s  %.1fx  reals %.3f s  %.1fx  results %s\n", tiers[tier].first.c_str(), integerSeconds, scalarSeconds[0] / integerSeconds,
+               realSeconds, scalarSeconds[1] / realSeconds, memcmp(expected, results, sizeof(results)) == 0 ? "match" : "differ");
+    }
+    return 0;
+}
@@ -0,0 +1,155 @@
+// Compares the symbol table with the std::map per data type layout it replaced
+// For 10, 1k and 100k variables it measures declaring every variable, declaring them again and looking them up
+
+#include <chrono>
+
+// The interpreter is a single translation unit, its main is renamed so that this file can have its own
+#define main symlsMain
+#include "../src/symls.cpp"
+#undef main
+
+// Nanoseconds per operation of f which does count operations
+template <typename F>
+double measure(long long count, F f)
+{
+    auto start = chrono::steady_clock::now();
+    f();
+    auto end = chrono::steady_clock::now();
+    return chrono::duration<double, nano>(end - start).count() / count;
+}
+
+// Defeats the optimizer throwing away the lookups
+volatile long long sink;
+
+void benchmark(int variables)
+{
+    vector<string> names;
+    for (int i = 0; i < variables; i++)
+    {
+        names.push_back("variable" + to_string(i));
+    }
+
+    // Every size declares from empty containers and looks up about the same number of times
+    int declareRounds = max(1, 400000 / variables);
+    long long declares = (long long)declareRounds * variables;
+    int rounds = max(1, 4000000 / variables);
+    long long lookups = (long long)rounds * variables;
+
+    // The previous layout, a map for each data type
+    map<string, int> integerMap;
+    map<string, string> textMap;
+    map<string, double> realMap;
+    double mapDeclare = measure(declares, [&]()
+                                {
+        for (int round = 0; round < declareRounds; round++)
+        {
+            integerMap.clear();
+            for (int i = 0; i < variables; i++)
+            {
+                integerMap[names[i]] = i;
+            }
+        } });
+    double mapRedeclare = measure(declares, [&]()
+                                  {
+        for (int round = 0; round < declareRounds; round++)
+        {
+            for (int i = 0; i < variables; i++)
+            {
+                integerMap[names[i]] = i + round;
+            }
+        } });
+    double mapLookup = measure(lookups, [&]()
+                               {
+        long long sum = 0;
+        for (int round = 0; round < rounds; round++)
+        {
+            for (auto &name : names)
+            {
+                // getVariable tried the maps in the order integer, text, real
+                auto found = integerMap.find(name);
+                if (found != integerMap.end())
+                    sum += found->second;
+                else if (textMap.find(name) != textMap.end())
+                    sum++;
+                else if (realMap.find(name) != realMap.end())
+                    sum--;
+            }
+        }
+        sink = sum; });
+
+    // The symbol table, the same work as let and getVariable do with it
+    auto clear = [&]()
+    {
+        symbolTable.clear();
+        identifierNames.clear();
+        identifierSlots.clear();
+        identifierArrays.clear();
+        slots.clear();
+    };
+    auto declare = [&](int offset)
+    {
+        for (int i = 0; i < variables; i++)
+        {
+            Slot &slot = slots[slotOf(internIdentifier(names[i]))];
+            slot.integer = i + offset;
+            slot.types |= 1 << INTEGER;
+        }
+    };
+    double tableDeclare = measure(declares, [&]()
+                                  {
+        for (int round = 0; round < declareRounds; round++)
+        {
+            clear();
+            declare(0);
+        } });
+    double tableRedeclare = measure(declares, [&]()
+                                    {
+        for (int round = 0; round < declareRounds; round++)
+        {
+            declare(round);
+        } });
+    double tableLookup = measure(lookups, [&]()
+                                 {
+        long long sum = 0;
+        for (int round = 0; round < rounds; round++)
+        {
+            for (auto &name : names)
+            {
+                int identifier = findIdentifier(name);
+                if (identifier != -1 && identifierSlots[identifier] != -1)
+                    sum += slots[identifierSlots[identifier]].integer;
+            }
+        }
+        sink = sum; });
+
+    // Resolved tokens skip the hashing, the interpreter looks variables up this way
+    vector<int> identifiers;
+    for (auto &name : names)
+    {
+        identifiers.push_back(findIdentifier(name));
+    }
+    double resolvedLookup = measure(lookups, [&]()
+                                    {
+        long long sum = 0;
+        for (int round = 0; round < rounds; round++)
+        {
+            for (int identifier : identifiers)
+            {
+                sum += slots[identifierSlots[identifier]].integer;
+            }
+        }
+        sink = sum; });
+
+    printf("%7d variables   declare %7.1f ns / %7.1f ns   redeclare %7.1f ns / %7.1f ns   lookup %7.1f ns / %7.1f ns   resolved %5.1f ns\n",
+           variables, mapDeclare, tableDeclare, mapRedeclare, tableRedeclare, mapLookup, tableLookup, resolvedLookup);
+}
+
+int main()
+{
+    printf("Times are per variable, std::map / symbol table\n");
+    for (int variables : {10, 1000, 100000})
+    {
+        benchmark(variables);
+    }
+    return 0;
+}
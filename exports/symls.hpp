@@ -25,6 +25,86 @@ namespace symboless
             int type;
         } Multitype;
 
+        // A single word of a preprocessed line
+        // id is the keyword, operator or data type for those tokens and an index into
+        // numberLiterals, textLiterals or identifierNames for the others
+        typedef struct
+        {
+            int type;
+            int id;
+        } Token;
+
+        // Condition of an if or a while, leftHalf is logic rightHalf
+        typedef struct
+        {
+            std::vector<Token> left;
+            int logic;
+            std::vector<Token> right;
+        } Condition;
+
+        // A parsed statement, the blocks of if and while are already separated
+        struct Statement
+        {
+            int type;
+
+            // Error to report when the statement is reached, -1 if there is none
+            int error;
+
+            // let: data type of the variable
+            int dataType;
+
+            // let and assignment: the variable, goto: the subroutine
+            Token target;
+
+            // let and assignment: the expression to solve
+            std::vector<Token> value;
+
+            // print and read: the values chained with then
+            std::vector<Token> items;
+
+            // if and while: the condition and the blocks
+            Condition condition;
+            std::vector<Statement> body;
+            std::vector<Statement> otherwise;
+        };
+
+        // A variable, a name can be declared with more than one data type, types has one bit for each of them
+        typedef struct
+        {
+            int types;
+            int integer;
+            double real;
+            std::string text;
+        } Slot;
+
+        // The values of an array, a name can be declared as more than one kind of array
+        // types has one bit for each of them like the types of a slot
+        typedef struct
+        {
+            int types;
+            std::vector<int> integers;
+            std::vector<double> reals;
+            std::vector<std::string> texts;
+        } Array;
+
+        // A bucket of the symbol table, the hash is kept so that probing rarely compares names
+        typedef struct
+        {
+            unsigned int hash;
+            int identifier;
+        } SymbolBucket;
+
+        // Compiled form of a program for the virtual machine
+        // Instructions and their operands are stored one after the other in code
+        typedef struct
+        {
+            std::vector<int> code;
+            std::vector<double> realConstants;
+
+            // Operands of the calls which wait for the address of their subroutine
+            std::vector<std::pair<int, std::string>> calls;
+        } Bytecode;
+
         // To store scripts
         std::string originalScript;
         std::string processedScript;
@@ -33,15 +113,30 @@ namespace symboless
         std::istringstream inputStream;
         std::ostringstream outputStream;
 
-        // To store the variables
-        std::map<std::string, int> integerVariables;
-        std::map<std::string, std::string> textVariables;
-        std::map<std::string, double> realVariables;
-        std::map<std::string, std::vector<int>> integerArrays;
-        std::map<std::string, std::vector<std::string>> textArrays;
-        std::map<std::string, std::vector<double>> realArrays;
+        // To store the subroutines
         std::map<std::string, std::vector<std::string>> subroutines;
 
+        // Types every variable and array is declared with anywhere in the program, one bit per data type
+        std::map<std::string, int> declaredTypes;
+
+        // Jumps of the escape and recheck statements in the loop being compiled and in the loops around it
+        // They are patched to the end of the loop and to its condition, outside of a loop to the end of the line
+        std::vector<std::vector<int>> escapeJumps;
+        std::vector<std::vector<int>> recheckJumps;
+
+        // Symbol table, open addressing from the names to their identifiers, empty buckets have the identifier -1
+        // For every identifier its name, its variable and its array are kept, the array is -1 until the
+        // name is declared as one
+        std::vector<SymbolBucket> symbolTable;
+        std::vector<std::string> identifierNames;
+        std::vector<Slot> variables;
+        std::vector<int> identifierArrays;
+        std::vector<Array> arrays;
+
+        // Literals referred to by the tokens
+        std::vector<std::string> numberLiterals;
+        std::vector<std::string> textLiterals;
+
         // Constants
         const int DEFAULT_ARRAY_SIZE = 64;
         const int DEFAULT_INTEGER_VALUE = 0;
@@ -97,6 +192,105 @@ namespace symboless
             SUBROUTINE
         };
 
+        enum TOKEN_TYPES
+        {
+            KEYWORD_TOKEN,
+            OPERATOR_TOKEN,
+            DATA_TYPE_TOKEN,
+            NUMBER_TOKEN,
+            STRING_TOKEN,
+            IDENTIFIER_TOKEN
+        };
+
+        enum STATEMENT_TYPES
+        {
+            LET_STATEMENT,
+            ASSIGN_STATEMENT,
+            PRINT_STATEMENT,
+            READ_STATEMENT,
+            IF_STATEMENT,
+            WHILE_STATEMENT,
+            GOTO_STATEMENT,
+            ESCAPE_STATEMENT,
+            RECHECK_STATEMENT,
+            END_STATEMENT,
+            SKIP_STATEMENT,
+            INVALID_STATEMENT
+        };
+
+        enum INSTRUCTIONS
+        {
+            // Push a value on the stack of its type, the operand is the value or its constant
+            PUSH_INTEGER,
+            PUSH_REAL,
+            PUSH_TEXT,
+
+            // Push the value of a variable, the operand is the identifier of the variable
+            LOAD_INTEGER,
+            LOAD_REAL,
+            LOAD_TEXT,
+
+            // Pop the value into an existing or a new variable
+            STORE_INTEGER,
+            STORE_REAL,
+            STORE_TEXT,
+            DECLARE_INTEGER,
+            DECLARE_REAL,
+            DECLARE_TEXT,
+
+            // Pop the size and create the array
+            DECLARE_INTEGER_ARRAY,
+            DECLARE_REAL_ARRAY,
+            DECLARE_TEXT_ARRAY,
+
+            // Arithmetic on the top two values
+            ADD_INTEGER,
+            SUBTRACT_INTEGER,
+            DIVIDE_INTEGER,
+            MULTIPLY_INTEGER,
+            MODULO_INTEGER,
+            POWER_INTEGER,
+            ADD_REAL,
+            SUBTRACT_REAL,
+            DIVIDE_REAL,
+            MULTIPLY_REAL,
+            MODULO_REAL,
+            POWER_REAL,
+            JOIN_TEXT,
+
+            // Compare the top two values and push 1 or 0 on the integer stack
+            LESS_INTEGER,
+            GREATER_INTEGER,
+            EQUAL_INTEGER,
+            NOT_EQUAL_INTEGER,
+            LESS_REAL,
+            GREATER_REAL,
+            EQUAL_REAL,
+            NOT_EQUAL_REAL,
+            LESS_TEXT,
+            GREATER_TEXT,
+            EQUAL_TEXT,
+            NOT_EQUAL_TEXT,
+
+            // Control flow, the operands are addresses in the code
+            JUMP,
+            JUMP_IF_FALSE,
+            SWITCH_TYPE,
+            CALL,
+            RETURN,
+
+            // Input and output
+            PRINT_LITERAL,
+            PRINT_VARIABLE,
+            READ_VARIABLE,
+
+            // Bookkeeping
+            CHECK_VARIABLE,
+            NEXT_LINE,
+            RAISE,
+            HALT
+        };
+
         enum ERRORS
         {
             INVALID_SYNTAX,
@@ -107,6 +301,14 @@ namespace symboless
             INVALID_NAME
         };
 
+        // How the tree walker leaves a block, escape and recheck skip the rest of it
+        enum FLOWS
+        {
+            NEXT_FLOW,
+            ESCAPE_FLOW,
+            RECHECK_FLOW
+        };
+
         // Default values for keywords, data types, operators and error messages
         const std::map<std::string, int> mathOperators = {
             {"plus", PLUS},
@@ -199,11 +401,12 @@ namespace symboless
             {INVALID_NAME, "Invalid name"}};
 
         // Status variables
-        int currentLine = 0, escape = 0, recheckCondition = 0;
+        int currentLine = 0;
 
         // Interpreter functions
 
-        void interpret(std::string &expr)
+        // Return how the expressions end, escape and recheck skip the rest of them and are handed to the loop around
+        int interpret(std::string &expr)
         {
             // expression1 and expression2 and ....
             // set cursor at the beginning of the line
@@ -215,7 +418,7 @@ namespace symboless
             // If the line is empty
             if (expr[cursor] == '\0')
             {
-                return;
+                return NEXT_FLOW;
             }
 
             // To read the first word of the line
@@ -232,9 +435,12 @@ namespace symboless
                 {
                     std::string part1 = expr.substr(0, j);
                     std::string part2 = expr.substr(j + keywordsToString.at(AND).length());
-                    interpret(part1);
-                    interpret(part2);
-                    return;
+                    int flow = interpret(part1);
+                    if (flow != NEXT_FLOW)
+                    {
+                        return flow;
+                    }
+                    return interpret(part2);
                 }
             }
             if (temp == keywordsToString.at(LET))
@@ -304,13 +510,10 @@ namespace symboless
                 expressionWhenTrue = expr.substr(cursor, conjugateElsePosition - cursor);
                 expressionWhenFalse = expr.substr(conjugateElsePosition + keywordsToString.at(ELSE).length(), conjugateStopPosition - conjugateElsePosition - keywordsToString.at(ELSE).length());
 
-                if (checkCondition(condition))
-                {
-                    interpret(expressionWhenTrue);
-                }
-                else
+                int flow = checkCondition(condition) ? interpret(expressionWhenTrue) : interpret(expressionWhenFalse);
+                if (flow != NEXT_FLOW)
                 {
-                    interpret(expressionWhenFalse);
+                    return flow;
                 }
 
                 // Move the cursor to the position after STOP
@@ -319,8 +522,7 @@ namespace symboless
                 {
                     // Interpret the next expression
                     std::string nextExpression = expr.substr(cursor + keywordsToString.at(AND).length());
-                    interpret(nextExpression);
-                    return;
+                    return interpret(nextExpression);
                 }
             }
             else if (temp == keywordsToString.at(WHILE))
@@ -360,23 +562,13 @@ namespace symboless
 
                 // The expression is between cursor and tillherePosition
                 std::string expression = expr.substr(cursor, tillherePosition - cursor);
+                // escape leaves the loop at once, recheck goes straight back to the condition
                 while (checkCondition(condition))
                 {
-                    // If escape was triggered then break out of the loop
-                    if (escape)
+                    if (interpret(expression) == ESCAPE_FLOW)
                     {
-                        escape = 0;
                         break;
                     }
-
-                    // If recheck condition was triggered then continue the loop
-                    if (recheckCondition)
-                    {
-                        recheckCondition = 0;
-                        continue;
-                    }
-
-                    interpret(expression);
                 }
 
                 // Move the cursor to the position after TILLHERE
@@ -385,8 +577,7 @@ namespace symboless
                 {
                     // Interpret the next expression
                     std::string nextExpression = expr.substr(cursor + keywordsToString.at(AND).length());
-                    interpret(nextExpression);
-                    return;
+                    return interpret(nextExpression);
                 }
             }
             else if (temp == keywordsToString.at(GOTO))
@@ -399,17 +590,15 @@ namespace symboless
                 readUntilNextSpace(expr, cursor, subroutineName);
 
                 // Interpret the subroutine
+                // Outside of a loop escape leaves the subroutine and recheck the rest of its line
                 for (auto &line : subroutines[subroutineName])
                 {
-                    // If escape was triggered then break out of the subroutine
-                    if (escape)
+                    if (interpret(line) == ESCAPE_FLOW)
                     {
-                        escape = 0;
-                        return;
+                        break;
                     }
-                    interpret(line);
                 }
-                return;
+                return NEXT_FLOW;
             }
             else if (temp == keywordsToString.at(READ))
             {
@@ -417,11 +606,11 @@ namespace symboless
             }
             else if (temp == keywordsToString.at(LEAVE))
             {
-                return;
+                return NEXT_FLOW;
             }
             else if (temp == keywordsToString.at(SKIP))
             {
-                return;
+                return NEXT_FLOW;
             }
             else if (temp == keywordsToString.at(END))
             {
@@ -429,13 +618,11 @@ namespace symboless
             }
             else if (temp == keywordsToString.at(ESCAPE))
             {
-                escape = 1;
-                return;
+                return ESCAPE_FLOW;
             }
             else if (temp == keywordsToString.at(RECHECK))
             {
-                recheckCondition = 1;
-                return;
+                return RECHECK_FLOW;
             }
             else
             {
@@ -476,6 +663,7 @@ namespace symboless
                     exit(0);
                 }
             }
+            return NEXT_FLOW;
         }
 
         int solveForInteger(std::string &expr, int &position)
@@ -940,18 +1128,20 @@ namespace symboless
                         size = DEFAULT_ARRAY_SIZE;
                     }
                 }
+                Array &array = arrayOf(internIdentifier(arrayName));
                 if (type == INTEGER_ARRAY)
                 {
-                    integerArrays[arrayName] = std::vector<int>(size, DEFAULT_INTEGER_VALUE);
+                    array.integers.assign(size, DEFAULT_INTEGER_VALUE);
                 }
                 else if (type == TEXT_ARRAY)
                 {
-                    textArrays[arrayName] = std::vector<std::string>(size, DEFAULT_TEXT_VALUE);
+                    array.texts.assign(size, DEFAULT_TEXT_VALUE);
                 }
                 else if (type == REAL_ARRAY)
                 {
-                    realArrays[arrayName] = std::vector<double>(size, DEFAULT_REAL_VALUE);
+                    array.reals.assign(size, DEFAULT_REAL_VALUE);
                 }
+                array.types |= 1 << type;
                 return;
             }
 
@@ -967,18 +1157,20 @@ namespace symboless
             trim(expr, cursor);
             if (expr[cursor] == '\0')
             {
+                Slot &variable = variables[internIdentifier(name)];
                 switch (type)
                 {
                 case INTEGER:
-                    integerVariables[name] = DEFAULT_INTEGER_VALUE;
+                    variable.integer = DEFAULT_INTEGER_VALUE;
                     break;
                 case TEXT:
-                    textVariables[name] = DEFAULT_TEXT_VALUE;
+                    variable.text = DEFAULT_TEXT_VALUE;
                     break;
                 case REAL:
-                    realVariables[name] = DEFAULT_REAL_VALUE;
+                    variable.real = DEFAULT_REAL_VALUE;
                     break;
                 }
+                variable.types |= 1 << type;
                 return;
             }
 
@@ -996,19 +1188,21 @@ namespace symboless
                 exit(0);
             }
 
-            // Initiate the variable with the value
+            // Initiate the variable with the value, it gets its type once the value is solved
+            int identifier = internIdentifier(name);
             if (type == INTEGER)
             {
-                integerVariables[name] = solveForInteger(expr, cursor);
+                variables[identifier].integer = solveForInteger(expr, cursor);
             }
             else if (type == TEXT)
             {
-                textVariables[name] = solveForText(expr, cursor);
+                variables[identifier].text = solveForText(expr, cursor);
             }
             else if (type == REAL)
             {
-                realVariables[name] = solveForReal(expr, cursor);
+                variables[identifier].real = solveForReal(expr, cursor);
             }
+            variables[identifier].types |= 1 << type;
         }
 
         void printOutput(std::string &expr, int &position)
@@ -1144,245 +1338,1682 @@ namespace symboless
             outputStream << errorMassage.at(errCode) << std::endl;
         }
 
-        // Utility Functions
+        // Tokenizer functions
 
-        int power(int number, int exponent)
+        // Break a preprocessed line into tokens
+        void tokenize(std::string &line, std::vector<Token> &tokens)
         {
-            int result = 1;
-            for (int i = 0; i < exponent; i++)
+            int cursor = 0;
+            trim(line, cursor);
+            while (line[cursor] != '\0')
             {
-                result *= number;
+                std::string word = "";
+                readUntilNextSpace(line, cursor, word);
+                tokens.push_back(classifyWord(word));
+                trim(line, cursor);
             }
-            return result;
         }
 
-        // Move the cursor to the first character
-        void trim(std::string &str, int &position)
+        // Find out what a single word of the program is
+        Token classifyWord(std::string &word)
         {
-            while (str[position] == ' ' && str[position] != '\0')
+            Token token;
+
+            // newline is a predefined text variable and not a statement
+            if (keywords.find(word) != keywords.end() && keywords.at(word) != NEWLINE)
             {
-                position++;
+                token.type = KEYWORD_TOKEN;
+                token.id = keywords.at(word);
+            }
+            else if (mathOperators.find(word) != mathOperators.end())
+            {
+                token.type = OPERATOR_TOKEN;
+                token.id = mathOperators.at(word);
+            }
+            else if (logicalOperators.find(word) != logicalOperators.end())
+            {
+                token.type = OPERATOR_TOKEN;
+                token.id = logicalOperators.at(word);
+            }
+            else if (dataTypes.find(word) != dataTypes.end())
+            {
+                token.type = DATA_TYPE_TOKEN;
+                token.id = dataTypes.at(word);
             }
-        }
 
-        // Read the expression until the next space
-        void readUntilNextSpace(std::string &expr, int &position, std::string &temp)
-        {
-            char checkFor = ' ';
-            if (expr[position] == '\'')
+            // Store string literals without the quotes
+            else if (isString(word))
             {
-                checkFor = '\'';
-                temp += expr[position];
-                position++;
+                token.type = STRING_TOKEN;
+                token.id = textLiterals.size();
+                textLiterals.push_back(word.substr(1, word.length() - 2));
             }
-            while (expr[position] != checkFor && expr[position] != '\0')
+            else if (isNumber(word))
             {
-                temp += expr[position];
-                position++;
+                token.type = NUMBER_TOKEN;
+                token.id = numberLiterals.size();
+                numberLiterals.push_back(word);
             }
-            if (checkFor == '\'' && expr[position] != '\0')
+            else
             {
-                temp += expr[position];
-                position++;
+                token.type = IDENTIFIER_TOKEN;
+                token.id = internIdentifier(word);
             }
+            return token;
         }
 
-        // Check if the next expression exists (AND keyword)
-        int nextExpressionExists(std::string &expr, int &position)
+        // Give every distinct name a small number so that tokens do not have to carry strings
+        int internIdentifier(std::string &name)
         {
-            return findKeyword(expr, position, AND);
-        }
+            int id = findIdentifier(name);
+            if (id != -1)
+            {
+                return id;
+            }
 
-        // Find a specific keyword in the expression and move the cursor to the first character of the keyword
-        int findKeyword(std::string &expr, int &position, int keyword)
-        {
-            while (position < expr.length() - keywordsToString.at(keyword).length())
+            // Keep at least half of the buckets empty so that probes stay short
+            if (2 * (identifierNames.size() + 1) > symbolTable.size())
             {
-                if (expr[position] == '\'')
+                std::vector<SymbolBucket> buckets(symbolTable.empty() ? 64 : 2 * symbolTable.size(), {0, -1});
+                for (auto &bucket : symbolTable)
                 {
-                    position++;
-                    while (expr[position] != '\'' && position < expr.length())
+                    if (bucket.identifier == -1)
+                        continue;
+                    int position = bucket.hash & (buckets.size() - 1);
+                    while (buckets[position].identifier != -1)
                     {
-                        position++;
+                        position = (position + 1) & (buckets.size() - 1);
                     }
-                    position++;
-                }
-                if (expr.substr(position, keywordsToString.at(keyword).length()) == keywordsToString.at(keyword))
-                {
-                    if ((position == 0 || expr[position - 1] == ' ') && (expr[position + keywordsToString.at(keyword).length()] == ' ' || expr[position + keywordsToString.at(keyword).length()] == '\0'))
-                        return true;
+                    buckets[position] = bucket;
                 }
-                position++;
+                symbolTable.swap(buckets);
             }
-            return false;
+
+            unsigned int hash = hashName(name);
+            int position = hash & (symbolTable.size() - 1);
+            while (symbolTable[position].identifier != -1)
+            {
+                position = (position + 1) & (symbolTable.size() - 1);
+            }
+            id = identifierNames.size();
+            symbolTable[position] = {hash, id};
+            identifierNames.push_back(name);
+            Slot variable;
+            variable.types = 0;
+            variable.integer = 0;
+            variable.real = 0.0;
+            variables.push_back(variable);
+            identifierArrays.push_back(-1);
+            return id;
         }
 
-        // Check if the std::string is a number
-        int isNumber(std::string &str)
+        // The identifier of a name, -1 if it was never interned
+        int findIdentifier(std::string &name)
         {
-            int dotCount = 0;
-            for (int i = 0; i < str.length(); i++)
+            if (symbolTable.empty())
             {
-                if (str[i] < '0' || str[i] > '9')
+                return -1;
+            }
+            unsigned int hash = hashName(name);
+            int position = hash & (symbolTable.size() - 1);
+            while (symbolTable[position].identifier != -1)
+            {
+                SymbolBucket &bucket = symbolTable[position];
+                if (bucket.hash == hash && identifierNames[bucket.identifier] == name)
                 {
-                    if (str[i] == '-' && i == 0)
-                    {
-                        continue;
-                    }
-                    if (str[i] == '.' && dotCount == 0)
-                    {
-                        dotCount++;
-                        continue;
-                    }
-                    return false;
+                    return bucket.identifier;
                 }
+                position = (position + 1) & (symbolTable.size() - 1);
             }
-            return true;
+            return -1;
         }
 
-        // Check if the std::string is a std::string literal (Enclosed in double quotes)
-        int isString(std::string &str)
+        // FNV-1a hash of a name
+        unsigned int hashName(std::string &name)
         {
-            if (str[0] == '\'' && str[str.length() - 1] == '\'')
+            unsigned int hash = 2166136261u;
+            for (char c : name)
             {
-                return true;
+                hash = (hash ^ (unsigned char)c) * 16777619u;
             }
-            return false;
+            return hash;
         }
 
-        // Check if the std::string is a real number
-        int isReal(std::string &str)
+        // The array of a name, it is made the first time the name is declared as an array
+        Array &arrayOf(int identifier)
         {
-            int dotCount = 0;
-            for (int i = 0; i < str.length(); i++)
-            {
-                if (str[i] < '0' || str[i] > '9')
-                {
-                    if (str[i] == '-' && i == 0)
-                    {
-                        continue;
-                    }
-                    if (str[i] == '.' && dotCount == 0)
-                    {
-                        dotCount++;
-                        continue;
-                    }
-                    return false;
-                }
-            }
-            if (dotCount == 1)
+            if (identifierArrays[identifier] == -1)
             {
-                return true;
+                identifierArrays[identifier] = arrays.size();
+                arrays.push_back(Array());
+                arrays.back().types = 0;
             }
-            return false;
+            return arrays[identifierArrays[identifier]];
         }
 
-        // Validate the name of the variable
-        int validateName(std::string name)
-        {
-            // Name cannot be empty
-            if (name[0] == '\n')
-                return false;
 
-            // Name cannot start with a number
-            if (name[0] >= '0' && name[0] <= '0')
-                return false;
+        // Parser functions
 
-            // Name can only contain alphabets and numbers
-            for (int i = 0; i < name.length(); i++)
+        // Parse a tokenized line into the statements chained with and
+        void parse(std::vector<Token> &tokens, std::vector<Statement> &statements)
+        {
+            int position = 0;
+            while (position < tokens.size())
             {
-                if (name[i] >= '0' && name[i] <= '9')
-                    continue;
-                if (name[i] >= 'a' && name[i] <= 'z')
-                    continue;
-                if (name[i] >= 'A' && name[i] <= 'Z')
-                    continue;
-                return false;
+                parseBlock(tokens, position, statements);
+
+                // A block closing keyword which does not close anything is reported when it is reached
+                if (position < tokens.size())
+                {
+                    Statement statement = newStatement(INVALID_STATEMENT);
+                    statement.error = VARIABLE_NOT_FOUND;
+                    statements.push_back(statement);
+                    position++;
+                    skipStatement(tokens, position);
+                }
             }
+        }
 
-            // Name cannot be a reserved keyword
-            for (auto reserved : reservedWords)
+        // Parse statements chained with and until else, stop or till-here closes the block
+        void parseBlock(std::vector<Token> &tokens, int &position, std::vector<Statement> &statements)
+        {
+            while (position < tokens.size())
             {
-                if (name.compare(reserved) == 0)
-                    return false;
+                // Empty statements are allowed, for example "and stop"
+                if (isKeyword(tokens[position], AND))
+                {
+                    position++;
+                    continue;
+                }
+                if (closesBlock(tokens[position]))
+                {
+                    return;
+                }
+                statements.push_back(parseStatement(tokens, position));
+
+                // Anything left between the end of an if or while and the next and is ignored
+                skipStatement(tokens, position);
             }
-            return true;
         }
 
-        Multitype getVariable(std::string varName)
+        Statement parseStatement(std::vector<Token> &tokens, int &position)
         {
-            // If the variable is an array
-            Multitype variable;
-            if (varName.find('-') != std::string::npos)
+            Token &first = tokens[position++];
+
+            // variable is expression
+            if (first.type != KEYWORD_TOKEN)
             {
-                // Seperate the name and index
-                std::string arrayName = varName.substr(0, varName.find('-'));
-                std::string indexString = varName.substr(varName.find('-') + 1);
+                Statement statement = newStatement(ASSIGN_STATEMENT);
+                statement.target = first;
+                if (position < tokens.size() && isKeyword(tokens[position], IS))
+                {
+                    position++;
+                }
+                else
+                {
+                    statement.error = INVALID_SYNTAX;
+                }
+                readExpression(tokens, position, statement.value);
+                return statement;
+            }
 
-                int dummy = 0;
-                int index = solveForInteger(indexString, dummy);
+            switch (first.id)
+            {
+            case LET:
+            {
+                // let dataType name is value
+                Statement statement = newStatement(LET_STATEMENT);
+                if (position < tokens.size() && tokens[position].type == DATA_TYPE_TOKEN)
+                {
+                    statement.dataType = tokens[position++].id;
+                }
+                else
+                {
+                    statement.error = INVALID_DATA_TYPE;
+                }
 
-                // Check the type of the array and store the address of the variable
-                if (integerArrays.find(arrayName) != integerArrays.end())
+                // Arrays carry their size in the name (name-size)
+                if (statement.error == -1 && position < tokens.size() && tokens[position].type == IDENTIFIER_TOKEN)
                 {
-                    if (index >= 0 && index < integerArrays[arrayName].size())
+                    statement.target = tokens[position++];
+                    std::string name = identifierNames[statement.target.id];
+                    if (statement.dataType == INTEGER_ARRAY || statement.dataType == TEXT_ARRAY || statement.dataType == REAL_ARRAY)
                     {
-                        variable.integer = &integerArrays[arrayName][index];
-                        variable.type = INTEGER;
+                        name = name.substr(0, name.find('-'));
                     }
-
-                    // If the index is out of bounds
-                    else
+                    if (validateName(name) == 0)
                     {
-                        printError(INDEX_OUT_OF_BOUNDS);
-                        exit(0);
+                        statement.error = INVALID_NAME;
                     }
                 }
-                else if (realArrays.find(arrayName) != realArrays.end())
+                else if (statement.error == -1)
                 {
-                    if (index >= 0 && index < realArrays[arrayName].size())
+                    statement.error = INVALID_NAME;
+                }
+
+                // The value is optional
+                if (statement.error == -1 && position < tokens.size() && !endsStatement(tokens[position]))
+                {
+                    if (isKeyword(tokens[position], IS))
                     {
-                        variable.real = &realArrays[arrayName][index];
-                        variable.type = REAL;
+                        position++;
+                        readExpression(tokens, position, statement.value);
                     }
                     else
                     {
-                        printError(INDEX_OUT_OF_BOUNDS);
-                        exit(0);
+                        statement.error = INVALID_SYNTAX;
                     }
                 }
-                else if (textArrays.find(arrayName) != textArrays.end())
+                return statement;
+            }
+            case PRINT:
+            case READ:
+            {
+                // print value then value then ....
+                Statement statement = newStatement(isKeyword(first, PRINT) ? PRINT_STATEMENT : READ_STATEMENT);
+                while (position < tokens.size() && !endsStatement(tokens[position]))
                 {
-                    if (index >= 0 && index < textArrays[arrayName].size())
+                    statement.items.push_back(tokens[position++]);
+                    if (position >= tokens.size() || endsStatement(tokens[position]))
                     {
-                        variable.text = &textArrays[arrayName][index];
-                        variable.type = TEXT;
+                        break;
                     }
-                    else
+                    if (!isKeyword(tokens[position], THEN))
                     {
-                        printError(INDEX_OUT_OF_BOUNDS);
-                        exit(0);
+                        statement.error = INVALID_SYNTAX;
+                        break;
                     }
+                    position++;
                 }
+                return statement;
             }
-            else if (integerVariables.find(varName) != integerVariables.end())
+            case IF:
             {
-                variable.integer = &integerVariables[varName];
-                variable.type = INTEGER;
-            }
-            else if (textVariables.find(varName) != textVariables.end())
-            {
-                variable.text = &textVariables[varName];
-                variable.type = TEXT;
+                // if condition then expression else expression stop
+                Statement statement = newStatement(IF_STATEMENT);
+                parseCondition(tokens, position, THEN, statement.condition);
+                parseBlock(tokens, position, statement.body);
+                if (position < tokens.size() && isKeyword(tokens[position], ELSE))
+                {
+                    position++;
+                    parseBlock(tokens, position, statement.otherwise);
+                }
+                if (position < tokens.size() && isKeyword(tokens[position], STOP))
+                {
+                    position++;
+                }
+                return statement;
+            }
+            case WHILE:
+            {
+                // while condition do expression and expression till-here
+                Statement statement = newStatement(WHILE_STATEMENT);
+                parseCondition(tokens, position, DO, statement.condition);
+                parseBlock(tokens, position, statement.body);
+                if (position < tokens.size() && isKeyword(tokens[position], TILLHERE))
+                {
+                    position++;
+                }
+                return statement;
+            }
+            case GOTO:
+            {
+                // goto subroutine-name
+                Statement statement = newStatement(GOTO_STATEMENT);
+                if (position < tokens.size())
+                {
+                    statement.target = tokens[position];
+                }
+                return statement;
+            }
+            case LEAVE:
+            {
+                // The rest of the block is a comment
+                while (position < tokens.size() && !closesBlock(tokens[position]))
+                {
+                    position++;
+                }
+                return newStatement(SKIP_STATEMENT);
+            }
+            case SKIP:
+                return newStatement(SKIP_STATEMENT);
+            case END:
+                return newStatement(END_STATEMENT);
+            case ESCAPE:
+                return newStatement(ESCAPE_STATEMENT);
+            case RECHECK:
+                return newStatement(RECHECK_STATEMENT);
+            default:
+            {
+                // Any other keyword can not start a statement
+                Statement statement = newStatement(INVALID_STATEMENT);
+                statement.error = VARIABLE_NOT_FOUND;
+                return statement;
+            }
+            }
+        }
+
+        // Parse "leftHalf is logic rightHalf" up to the keyword which ends the condition
+        void parseCondition(std::vector<Token> &tokens, int &position, int closing, Condition &condition)
+        {
+            while (position < tokens.size() && !isKeyword(tokens[position], closing) && !isKeyword(tokens[position], IS))
+            {
+                condition.left.push_back(tokens[position++]);
+            }
+            if (position < tokens.size() && isKeyword(tokens[position], IS))
+            {
+                position++;
+                if (position < tokens.size() && tokens[position].type == OPERATOR_TOKEN)
+                {
+                    condition.logic = tokens[position].id;
+                }
+                if (position < tokens.size() && !isKeyword(tokens[position], closing))
+                {
+                    position++;
+                }
+            }
+            while (position < tokens.size() && !isKeyword(tokens[position], closing))
+            {
+                condition.right.push_back(tokens[position++]);
+            }
+
+            // Skip the closing keyword
+            if (position < tokens.size())
+            {
+                position++;
+            }
+        }
+
+        // Copy the operands and operators of an expression until the statement ends
+        void readExpression(std::vector<Token> &tokens, int &position, std::vector<Token> &expr)
+        {
+            while (position < tokens.size() && !endsStatement(tokens[position]))
+            {
+                expr.push_back(tokens[position++]);
+            }
+        }
+
+        // Move the cursor to the and which starts the next statement, or to the end of the block
+        void skipStatement(std::vector<Token> &tokens, int &position)
+        {
+            while (position < tokens.size() && !endsStatement(tokens[position]))
+            {
+                position++;
+            }
+        }
+
+        Statement newStatement(int type)
+        {
+            Statement statement;
+            statement.type = type;
+            statement.error = -1;
+            statement.dataType = -1;
+            statement.target.type = -1;
+            statement.target.id = -1;
+            statement.condition.logic = -1;
+            return statement;
+        }
+
+
+        // Compiler functions
+
+        // Compile the lines of the main program and all the subroutines into one block of code
+        void compile(std::vector<std::vector<Statement>> &lines, Bytecode &bytecode)
+        {
+            // The types of the variables decide which instructions solve the expressions
+            for (auto &line : lines)
+            {
+                collectTypes(line);
+            }
+
+            // preprocess() keeps the subroutines as text, parse them once here
+            std::map<std::string, std::vector<std::vector<Statement>>> parsedSubroutines;
+            for (auto &subroutine : subroutines)
+            {
+                for (auto &line : subroutine.second)
+                {
+                    std::vector<Token> tokens;
+                    tokenize(line, tokens);
+                    parsedSubroutines[subroutine.first].push_back(std::vector<Statement>());
+                    parse(tokens, parsedSubroutines[subroutine.first].back());
+                    collectTypes(parsedSubroutines[subroutine.first].back());
+                }
+            }
+
+            // The main program counts the lines for the error messages
+            // Outside of a loop escape and recheck jump to the end of their line
+            for (auto &line : lines)
+            {
+                emit(bytecode, NEXT_LINE);
+                escapeJumps.push_back(std::vector<int>());
+                recheckJumps.push_back(std::vector<int>());
+                compileBlock(line, bytecode);
+                for (int jump : escapeJumps.back())
+                {
+                    patch(bytecode, jump);
+                }
+                for (int jump : recheckJumps.back())
+                {
+                    patch(bytecode, jump);
+                }
+                escapeJumps.pop_back();
+                recheckJumps.pop_back();
+            }
+            emit(bytecode, RETURN);
+
+            // In a subroutine escape jumps straight to its return instead
+            std::map<std::string, int> addresses;
+            for (auto &subroutine : parsedSubroutines)
+            {
+                addresses[subroutine.first] = bytecode.code.size();
+                std::vector<int> returns;
+                for (auto &line : subroutine.second)
+                {
+                    escapeJumps.push_back(std::vector<int>());
+                    recheckJumps.push_back(std::vector<int>());
+                    compileBlock(line, bytecode);
+                    returns.insert(returns.end(), escapeJumps.back().begin(), escapeJumps.back().end());
+                    for (int jump : recheckJumps.back())
+                    {
+                        patch(bytecode, jump);
+                    }
+                    escapeJumps.pop_back();
+                    recheckJumps.pop_back();
+                }
+                for (int jump : returns)
+                {
+                    patch(bytecode, jump);
+                }
+                emit(bytecode, RETURN);
+            }
+
+            // Calls to subroutines which do not exist do nothing
+            int missing = bytecode.code.size();
+            emit(bytecode, RETURN);
+            for (auto &call : bytecode.calls)
+            {
+                auto found = addresses.find(call.second);
+                bytecode.code[call.first] = found != addresses.end() ? found->second : missing;
+            }
+            bytecode.calls.clear();
+        }
+
+        void compileBlock(std::vector<Statement> &statements, Bytecode &bytecode)
+        {
+            for (auto &statement : statements)
+            {
+                compileStatement(statement, bytecode);
+            }
+        }
+
+        void compileStatement(Statement &statement, Bytecode &bytecode)
+        {
+            switch (statement.type)
+            {
+            case ASSIGN_STATEMENT:
+            {
+                // Only identifiers can name a variable
+                if (statement.target.type != IDENTIFIER_TOKEN)
+                {
+                    emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+                    break;
+                }
+
+                // If the IS keyword was missing
+                if (statement.error != -1)
+                {
+                    emit(bytecode, CHECK_VARIABLE, statement.target.id);
+                    emit(bytecode, RAISE, statement.error);
+                    break;
+                }
+
+                // A variable declared with one type is stored without looking at its type again
+                // An array element is looked up before the expression is solved, like in the interpreter
+                int type = staticType(statement.target);
+                if (type != -1 && identifierNames[statement.target.id].find('-') == std::string::npos)
+                {
+                    compileExpression(statement.value, type, bytecode);
+                    emit(bytecode, type == INTEGER ? STORE_INTEGER : type == TEXT ? STORE_TEXT : STORE_REAL, statement.target.id);
+                    break;
+                }
+
+                // Otherwise choose the instructions by the type the variable has when it is reached
+                emit(bytecode, SWITCH_TYPE, statement.target.id);
+                int cases = emit(bytecode, -1);
+                emit(bytecode, -1);
+                emit(bytecode, -1);
+                std::vector<int> exits;
+                for (int type : {INTEGER, TEXT, REAL})
+                {
+                    patch(bytecode, cases + type);
+                    compileExpression(statement.value, type, bytecode);
+                    emit(bytecode, type == INTEGER ? STORE_INTEGER : type == TEXT ? STORE_TEXT : STORE_REAL, statement.target.id);
+                    exits.push_back(emit(bytecode, JUMP, -1));
+                }
+                for (int exit : exits)
+                {
+                    patch(bytecode, exit);
+                }
+                break;
+            }
+            case LET_STATEMENT:
+            {
+                // Report the errors found while parsing
+                if (statement.error != -1)
+                {
+                    emit(bytecode, RAISE, statement.error);
+                    break;
+                }
+
+                int type = statement.dataType;
+                std::string name = identifierNames[statement.target.id];
+                if (type == INTEGER_ARRAY || type == TEXT_ARRAY || type == REAL_ARRAY)
+                {
+                    // The part before '-' is the name and after is the size
+                    std::string arrayName = name;
+                    if (name.find('-') != std::string::npos)
+                    {
+                        arrayName = name.substr(0, name.find('-'));
+                        std::string sizeString = name.substr(name.find('-') + 1);
+                        if (isNumber(sizeString))
+                        {
+                            Token size = {NUMBER_TOKEN, (int)numberLiterals.size()};
+                            numberLiterals.push_back(sizeString);
+                            compileOperand(size, INTEGER, bytecode);
+                        }
+                        else
+                        {
+                            emit(bytecode, LOAD_INTEGER, internIdentifier(sizeString));
+                        }
+                    }
+                    else
+                    {
+                        emit(bytecode, PUSH_INTEGER, DEFAULT_ARRAY_SIZE);
+                    }
+                    emit(bytecode, type == INTEGER_ARRAY ? DECLARE_INTEGER_ARRAY : type == TEXT_ARRAY ? DECLARE_TEXT_ARRAY : DECLARE_REAL_ARRAY, internIdentifier(arrayName));
+                    break;
+                }
+
+                if (statement.value.empty())
+                {
+                    compileDefault(type, bytecode);
+                }
+                else
+                {
+                    compileExpression(statement.value, type, bytecode);
+                }
+                emit(bytecode, type == INTEGER ? DECLARE_INTEGER : type == TEXT ? DECLARE_TEXT : DECLARE_REAL, statement.target.id);
+                break;
+            }
+            case PRINT_STATEMENT:
+            case READ_STATEMENT:
+            {
+                for (auto &value : statement.items)
+                {
+                    if (statement.type == PRINT_STATEMENT && value.type == STRING_TOKEN)
+                    {
+                        emit(bytecode, PRINT_LITERAL, value.id);
+                    }
+                    else if (value.type == IDENTIFIER_TOKEN)
+                    {
+                        emit(bytecode, statement.type == PRINT_STATEMENT ? PRINT_VARIABLE : READ_VARIABLE, value.id);
+                    }
+                    else
+                    {
+                        emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+                    }
+                }
+
+                // If the values were not chained properly
+                if (statement.error != -1)
+                {
+                    emit(bytecode, RAISE, statement.error);
+                }
+                break;
+            }
+            case IF_STATEMENT:
+            {
+                // condition, jump to else if false, body, jump over else
+                compileCondition(statement.condition, bytecode);
+                int otherwise = emit(bytecode, JUMP_IF_FALSE, -1);
+                compileBlock(statement.body, bytecode);
+                int exit = emit(bytecode, JUMP, -1);
+                patch(bytecode, otherwise);
+                compileBlock(statement.otherwise, bytecode);
+                patch(bytecode, exit);
+                break;
+            }
+            case WHILE_STATEMENT:
+            {
+                // escape jumps to the end of the loop and recheck back to the condition, nothing is checked on every pass
+                int start = bytecode.code.size();
+                compileCondition(statement.condition, bytecode);
+                int exit = emit(bytecode, JUMP_IF_FALSE, -1);
+                escapeJumps.push_back(std::vector<int>());
+                recheckJumps.push_back(std::vector<int>());
+                compileBlock(statement.body, bytecode);
+                emit(bytecode, JUMP, start);
+                for (int jump : recheckJumps.back())
+                {
+                    bytecode.code[jump] = start;
+                }
+                patch(bytecode, exit);
+                for (int jump : escapeJumps.back())
+                {
+                    patch(bytecode, jump);
+                }
+                escapeJumps.pop_back();
+                recheckJumps.pop_back();
+                break;
+            }
+            case GOTO_STATEMENT:
+            {
+                // The address of the subroutine is filled in once all of them are compiled
+                std::string subroutineName = "";
+                if (statement.target.type == IDENTIFIER_TOKEN)
+                {
+                    subroutineName = identifierNames[statement.target.id];
+                }
+                bytecode.calls.push_back({emit(bytecode, CALL, -1), subroutineName});
+                break;
+            }
+            case END_STATEMENT:
+                emit(bytecode, HALT);
+                break;
+            case ESCAPE_STATEMENT:
+                escapeJumps.back().push_back(emit(bytecode, JUMP, -1));
+                break;
+            case RECHECK_STATEMENT:
+                recheckJumps.back().push_back(emit(bytecode, JUMP, -1));
+                break;
+            case SKIP_STATEMENT:
+                break;
+            default:
+                emit(bytecode, RAISE, statement.error);
+            }
+        }
+
+        // Leave 1 on the integer stack if the condition is true and 0 if it is not
+        void compileCondition(Condition &condition, Bytecode &bytecode)
+        {
+            // An empty condition is never true
+            if (condition.left.empty())
+            {
+                if (condition.logic != -1)
+                {
+                    emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+                }
+                emit(bytecode, PUSH_INTEGER, 0);
+                return;
+            }
+
+            // The first word of the condition decides how it is compared
+            Token &first = condition.left[0];
+            if (first.type == STRING_TOKEN)
+            {
+                compileComparison(condition, TEXT, bytecode);
+                return;
+            }
+            if (first.type == NUMBER_TOKEN)
+            {
+                compileComparison(condition, isReal(numberLiterals[first.id]) ? REAL : INTEGER, bytecode);
+                return;
+            }
+            if (first.type != IDENTIFIER_TOKEN)
+            {
+                emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+                return;
+            }
+
+            int type = staticType(first);
+            if (type != -1)
+            {
+                compileComparison(condition, type, bytecode);
+                return;
+            }
+
+            // The type of the variable is only known when the condition is reached
+            emit(bytecode, SWITCH_TYPE, first.id);
+            int cases = emit(bytecode, -1);
+            emit(bytecode, -1);
+            emit(bytecode, -1);
+            std::vector<int> exits;
+            for (int type : {INTEGER, TEXT, REAL})
+            {
+                patch(bytecode, cases + type);
+                compileComparison(condition, type, bytecode);
+                exits.push_back(emit(bytecode, JUMP, -1));
+            }
+            for (int exit : exits)
+            {
+                patch(bytecode, exit);
+            }
+        }
+
+        void compileComparison(Condition &condition, int type, Bytecode &bytecode)
+        {
+            int instruction = -1;
+            switch (condition.logic)
+            {
+            case LESS_THAN:
+                instruction = type == INTEGER ? LESS_INTEGER : type == TEXT ? LESS_TEXT : LESS_REAL;
+                break;
+            case GREATER_THAN:
+                instruction = type == INTEGER ? GREATER_INTEGER : type == TEXT ? GREATER_TEXT : GREATER_REAL;
+                break;
+            case EQUAL_TO:
+                instruction = type == INTEGER ? EQUAL_INTEGER : type == TEXT ? EQUAL_TEXT : EQUAL_REAL;
+                break;
+            case NOT_EQUAL_TO:
+                instruction = type == INTEGER ? NOT_EQUAL_INTEGER : type == TEXT ? NOT_EQUAL_TEXT : NOT_EQUAL_REAL;
+                break;
+            default:
+                emit(bytecode, RAISE, INVALID_OPERATOR);
+                return;
+            }
+            compileExpression(condition.left, type, bytecode);
+            compileExpression(condition.right, type, bytecode);
+            emit(bytecode, instruction);
+        }
+
+        // Push the operands from left to right and apply the operators from right to left,
+        // so that "a minus b minus c" is a - (b - c) like in the interpreter
+        void compileExpression(std::vector<Token> &expr, int type, Bytecode &bytecode)
+        {
+            if (expr.empty())
+            {
+                compileZero(type, bytecode);
+                return;
+            }
+
+            std::vector<int> operators;
+            int position = 0;
+            while (true)
+            {
+                compileOperand(expr[position++], type, bytecode);
+                if (position >= expr.size())
+                {
+                    break;
+                }
+
+                // Read the operator
+                Token &op = expr[position++];
+                int instruction = -1;
+                if (op.type == OPERATOR_TOKEN && type == TEXT)
+                {
+                    // Texts can only be joined together
+                    instruction = op.id == PLUS ? JOIN_TEXT : -1;
+                }
+                else if (op.type == OPERATOR_TOKEN)
+                {
+                    switch (op.id)
+                    {
+                    case PLUS:
+                        instruction = type == INTEGER ? ADD_INTEGER : ADD_REAL;
+                        break;
+                    case MINUS:
+                        instruction = type == INTEGER ? SUBTRACT_INTEGER : SUBTRACT_REAL;
+                        break;
+                    case UPON:
+                        instruction = type == INTEGER ? DIVIDE_INTEGER : DIVIDE_REAL;
+                        break;
+                    case INTO:
+                        instruction = type == INTEGER ? MULTIPLY_INTEGER : MULTIPLY_REAL;
+                        break;
+                    case MODULO:
+                        instruction = type == INTEGER ? MODULO_INTEGER : MODULO_REAL;
+                        break;
+                    case EXPONENT:
+                        instruction = type == INTEGER ? POWER_INTEGER : POWER_REAL;
+                        break;
+                    }
+                }
+                if (instruction == -1)
+                {
+                    emit(bytecode, RAISE, INVALID_SYNTAX);
+                    return;
+                }
+                operators.push_back(instruction);
+
+                // A missing operand at the end counts as zero
+                if (position >= expr.size())
+                {
+                    compileZero(type, bytecode);
+                    break;
+                }
+            }
+            for (int i = operators.size() - 1; i >= 0; i--)
+            {
+                emit(bytecode, operators[i]);
+            }
+        }
+
+        void compileOperand(Token &operand, int type, Bytecode &bytecode)
+        {
+            if (operand.type == IDENTIFIER_TOKEN)
+            {
+                emit(bytecode, type == INTEGER ? LOAD_INTEGER : type == TEXT ? LOAD_TEXT : LOAD_REAL, operand.id);
+            }
+            else if (operand.type == NUMBER_TOKEN && type != TEXT)
+            {
+                // The number is converted once here instead of every time it is used
+                try
+                {
+                    if (type == INTEGER)
+                    {
+                        emit(bytecode, PUSH_INTEGER, std::stoi(numberLiterals[operand.id]));
+                    }
+                    else
+                    {
+                        emit(bytecode, PUSH_REAL, bytecode.realConstants.size());
+                        bytecode.realConstants.push_back(std::stod(numberLiterals[operand.id]));
+                    }
+                }
+                catch (std::exception &)
+                {
+                    emit(bytecode, RAISE, INVALID_SYNTAX);
+                }
+            }
+            else if (operand.type == STRING_TOKEN && type == TEXT)
+            {
+                emit(bytecode, PUSH_TEXT, operand.id);
+            }
+            else
+            {
+                emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+            }
+        }
+
+        // Push the configured default value of a type
+        void compileDefault(int type, Bytecode &bytecode)
+        {
+            if (type == INTEGER)
+            {
+                emit(bytecode, PUSH_INTEGER, DEFAULT_INTEGER_VALUE);
+            }
+            else if (type == TEXT)
+            {
+                emit(bytecode, PUSH_TEXT, textLiterals.size());
+                textLiterals.push_back(DEFAULT_TEXT_VALUE);
+            }
+            else
+            {
+                emit(bytecode, PUSH_REAL, bytecode.realConstants.size());
+                bytecode.realConstants.push_back(DEFAULT_REAL_VALUE);
+            }
+        }
+
+        // Push the value of an empty expression
+        void compileZero(int type, Bytecode &bytecode)
+        {
+            if (type == INTEGER)
+            {
+                emit(bytecode, PUSH_INTEGER, 0);
+            }
+            else if (type == TEXT)
+            {
+                emit(bytecode, PUSH_TEXT, textLiterals.size());
+                textLiterals.push_back("");
+            }
+            else
+            {
+                emit(bytecode, PUSH_REAL, bytecode.realConstants.size());
+                bytecode.realConstants.push_back(0.0);
+            }
+        }
+
+        // Remember the data types each name is declared with
+        void collectTypes(std::vector<Statement> &statements)
+        {
+            for (auto &statement : statements)
+            {
+                if (statement.type == LET_STATEMENT && statement.error == -1)
+                {
+                    std::string name = identifierNames[statement.target.id];
+                    int type = statement.dataType;
+                    if (type == INTEGER_ARRAY || type == TEXT_ARRAY || type == REAL_ARRAY)
+                    {
+                        name = name.substr(0, name.find('-'));
+                    }
+                    declaredTypes[name] |= 1 << type;
+                }
+                collectTypes(statement.body);
+                collectTypes(statement.otherwise);
+            }
+        }
+
+        // The type a variable or an array element always has, -1 if it can change while running
+        int staticType(Token &token)
+        {
+            if (token.type != IDENTIFIER_TOKEN)
+            {
+                return -1;
+            }
+            std::string name = identifierNames[token.id];
+
+            // newline is declared before the program starts
+            if (name.compare(keywordsToString.at(NEWLINE)) == 0)
+            {
+                return declaredTypes[name] == 0 ? TEXT : -1;
+            }
+
+            // An element has the type of its array
+            int types = 0;
+            if (name.find('-') != std::string::npos)
+            {
+                int arrayTypes = declaredTypes[name.substr(0, name.find('-'))];
+                for (int type : {INTEGER, TEXT, REAL})
+                {
+                    if (arrayTypes & (1 << (type + INTEGER_ARRAY)))
+                    {
+                        types |= 1 << type;
+                    }
+                }
+            }
+            else
+            {
+                types = declaredTypes[name] & ((1 << INTEGER) | (1 << TEXT) | (1 << REAL));
+            }
+
+            for (int type : {INTEGER, TEXT, REAL})
+            {
+                if (types == 1 << type)
+                {
+                    return type;
+                }
+            }
+            return -1;
+        }
+
+        int emit(Bytecode &bytecode, int instruction)
+        {
+            bytecode.code.push_back(instruction);
+            return bytecode.code.size() - 1;
+        }
+
+        // Return the position of the operand so that a jump can be patched later
+        int emit(Bytecode &bytecode, int instruction, int operand)
+        {
+            bytecode.code.push_back(instruction);
+            bytecode.code.push_back(operand);
+            return bytecode.code.size() - 1;
+        }
+
+        // Point a jump to the end of the code compiled so far
+        void patch(Bytecode &bytecode, int operand)
+        {
+            bytecode.code[operand] = bytecode.code.size();
+        }
+
+
+        // Virtual machine functions
+
+        void run(Bytecode &bytecode)
+        {
+            std::vector<int> &code = bytecode.code;
+
+            // A stack for every data type, conditions leave their result on the integer stack
+            std::vector<int> integers;
+            std::vector<double> reals;
+            std::vector<std::string> texts;
+
+            // Where to continue after a subroutine returns
+            std::vector<int> returns;
+
+            int pc = 0;
+            while (true)
+            {
+                switch (code[pc++])
+                {
+                case PUSH_INTEGER:
+                    integers.push_back(code[pc++]);
+                    break;
+                case PUSH_REAL:
+                    reals.push_back(bytecode.realConstants[code[pc++]]);
+                    break;
+                case PUSH_TEXT:
+                    texts.push_back(textLiterals[code[pc++]]);
+                    break;
+                case LOAD_INTEGER:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type == INTEGER)
+                    {
+                        integers.push_back(*var.integer);
+                    }
+                    else if (var.type == REAL)
+                    {
+                        integers.push_back(*var.real);
+                    }
+                    else
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    break;
+                }
+                case LOAD_REAL:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type == REAL)
+                    {
+                        reals.push_back(*var.real);
+                    }
+                    else if (var.type == INTEGER)
+                    {
+                        reals.push_back(*var.integer);
+                    }
+                    else
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    break;
+                }
+                case LOAD_TEXT:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type == TEXT)
+                    {
+                        texts.push_back(*var.text);
+                    }
+                    else
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    break;
+                }
+                case STORE_INTEGER:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type != INTEGER)
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    *var.integer = integers.back();
+                    integers.pop_back();
+                    break;
+                }
+                case STORE_REAL:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type != REAL)
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    *var.real = reals.back();
+                    reals.pop_back();
+                    break;
+                }
+                case STORE_TEXT:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type != TEXT)
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    *var.text = texts.back();
+                    texts.pop_back();
+                    break;
+                }
+                case DECLARE_INTEGER:
+                {
+                    Slot &variable = variables[code[pc++]];
+                    variable.integer = integers.back();
+                    variable.types |= 1 << INTEGER;
+                    integers.pop_back();
+                    break;
+                }
+                case DECLARE_REAL:
+                {
+                    Slot &variable = variables[code[pc++]];
+                    variable.real = reals.back();
+                    variable.types |= 1 << REAL;
+                    reals.pop_back();
+                    break;
+                }
+                case DECLARE_TEXT:
+                {
+                    Slot &variable = variables[code[pc++]];
+                    variable.text = texts.back();
+                    variable.types |= 1 << TEXT;
+                    texts.pop_back();
+                    break;
+                }
+                case DECLARE_INTEGER_ARRAY:
+                {
+                    Array &array = arrayOf(code[pc++]);
+                    array.integers.assign(integers.back(), DEFAULT_INTEGER_VALUE);
+                    array.types |= 1 << INTEGER_ARRAY;
+                    integers.pop_back();
+                    break;
+                }
+                case DECLARE_REAL_ARRAY:
+                {
+                    Array &array = arrayOf(code[pc++]);
+                    array.reals.assign(integers.back(), DEFAULT_REAL_VALUE);
+                    array.types |= 1 << REAL_ARRAY;
+                    integers.pop_back();
+                    break;
+                }
+                case DECLARE_TEXT_ARRAY:
+                {
+                    Array &array = arrayOf(code[pc++]);
+                    array.texts.assign(integers.back(), DEFAULT_TEXT_VALUE);
+                    array.types |= 1 << TEXT_ARRAY;
+                    integers.pop_back();
+                    break;
+                }
+
+                // The right operand is on top of the stack
+                case ADD_INTEGER:
+                    integers[integers.size() - 2] += integers.back();
+                    integers.pop_back();
+                    break;
+                case SUBTRACT_INTEGER:
+                    integers[integers.size() - 2] -= integers.back();
+                    integers.pop_back();
+                    break;
+                case DIVIDE_INTEGER:
+                    integers[integers.size() - 2] /= integers.back();
+                    integers.pop_back();
+                    break;
+                case MULTIPLY_INTEGER:
+                    integers[integers.size() - 2] *= integers.back();
+                    integers.pop_back();
+                    break;
+                case MODULO_INTEGER:
+                    integers[integers.size() - 2] %= integers.back();
+                    integers.pop_back();
+                    break;
+                case POWER_INTEGER:
+                    integers[integers.size() - 2] = power(integers[integers.size() - 2], integers.back());
+                    integers.pop_back();
+                    break;
+                case ADD_REAL:
+                    reals[reals.size() - 2] += reals.back();
+                    reals.pop_back();
+                    break;
+                case SUBTRACT_REAL:
+                    reals[reals.size() - 2] -= reals.back();
+                    reals.pop_back();
+                    break;
+                case DIVIDE_REAL:
+                    reals[reals.size() - 2] /= reals.back();
+                    reals.pop_back();
+                    break;
+                case MULTIPLY_REAL:
+                    reals[reals.size() - 2] *= reals.back();
+                    reals.pop_back();
+                    break;
+                case MODULO_REAL:
+                    reals[reals.size() - 2] = fmod(reals[reals.size() - 2], reals.back());
+                    reals.pop_back();
+                    break;
+                case POWER_REAL:
+                    reals[reals.size() - 2] = pow(reals[reals.size() - 2], reals.back());
+                    reals.pop_back();
+                    break;
+                case JOIN_TEXT:
+                    texts[texts.size() - 2] += texts.back();
+                    texts.pop_back();
+                    break;
+
+                // Comparisons
+                case LESS_INTEGER:
+                    integers[integers.size() - 2] = integers[integers.size() - 2] < integers.back();
+                    integers.pop_back();
+                    break;
+                case GREATER_INTEGER:
+                    integers[integers.size() - 2] = integers[integers.size() - 2] > integers.back();
+                    integers.pop_back();
+                    break;
+                case EQUAL_INTEGER:
+                    integers[integers.size() - 2] = integers[integers.size() - 2] == integers.back();
+                    integers.pop_back();
+                    break;
+                case NOT_EQUAL_INTEGER:
+                    integers[integers.size() - 2] = integers[integers.size() - 2] != integers.back();
+                    integers.pop_back();
+                    break;
+                case LESS_REAL:
+                    integers.push_back(reals[reals.size() - 2] < reals.back());
+                    reals.resize(reals.size() - 2);
+                    break;
+                case GREATER_REAL:
+                    integers.push_back(reals[reals.size() - 2] > reals.back());
+                    reals.resize(reals.size() - 2);
+                    break;
+                case EQUAL_REAL:
+                    integers.push_back(reals[reals.size() - 2] == reals.back());
+                    reals.resize(reals.size() - 2);
+                    break;
+                case NOT_EQUAL_REAL:
+                    integers.push_back(reals[reals.size() - 2] != reals.back());
+                    reals.resize(reals.size() - 2);
+                    break;
+                case LESS_TEXT:
+                    integers.push_back(texts[texts.size() - 2] < texts.back());
+                    texts.resize(texts.size() - 2);
+                    break;
+                case GREATER_TEXT:
+                    integers.push_back(texts[texts.size() - 2] > texts.back());
+                    texts.resize(texts.size() - 2);
+                    break;
+                case EQUAL_TEXT:
+                    integers.push_back(texts[texts.size() - 2].compare(texts.back()) == 0);
+                    texts.resize(texts.size() - 2);
+                    break;
+                case NOT_EQUAL_TEXT:
+                    integers.push_back(texts[texts.size() - 2].compare(texts.back()) != 0);
+                    texts.resize(texts.size() - 2);
+                    break;
+
+                // Control flow
+                case JUMP:
+                    pc = code[pc];
+                    break;
+                case JUMP_IF_FALSE:
+                    pc = integers.back() ? pc + 1 : code[pc];
+                    integers.pop_back();
+                    break;
+                case SWITCH_TYPE:
+                {
+                    // The three addresses follow the variable in the order integer, text, real
+                    Multitype var = getVariable(identifierNames[code[pc]]);
+                    if (var.type != INTEGER && var.type != TEXT && var.type != REAL)
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    pc = code[pc + 1 + var.type];
+                    break;
+                }
+                case CALL:
+                    returns.push_back(pc + 1);
+                    pc = code[pc];
+                    break;
+                case RETURN:
+                    // Returning from the main program ends the run
+                    if (returns.empty())
+                    {
+                        return;
+                    }
+                    pc = returns.back();
+                    returns.pop_back();
+                    break;
+
+                // Input and output
+                case PRINT_LITERAL:
+                    outputStream << textLiterals[code[pc++]];
+                    break;
+                case PRINT_VARIABLE:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type == INTEGER)
+                    {
+                        outputStream << *var.integer;
+                    }
+                    else if (var.type == TEXT)
+                    {
+                        outputStream << *var.text;
+                    }
+                    else if (var.type == REAL)
+                    {
+                        outputStream << *var.real;
+                    }
+                    else
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    break;
+                }
+                case READ_VARIABLE:
+                {
+                    Multitype var = getVariable(identifierNames[code[pc++]]);
+                    if (var.type == INTEGER)
+                    {
+                        inputStream >> *var.integer;
+                    }
+                    else if (var.type == TEXT)
+                    {
+                        inputStream >> *var.text;
+                    }
+                    else if (var.type == REAL)
+                    {
+                        inputStream >> *var.real;
+                    }
+                    else
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    break;
+                }
+
+                // Bookkeeping
+                case CHECK_VARIABLE:
+                    if (getVariable(identifierNames[code[pc++]]).type == -1)
+                    {
+                        printError(VARIABLE_NOT_FOUND);
+                        exit(0);
+                    }
+                    break;
+                case NEXT_LINE:
+                    currentLine++;
+                    break;
+                case RAISE:
+                    printError(code[pc]);
+                    exit(0);
+                    break;
+                case HALT:
+                    endProgram();
+                    break;
+                }
+            }
+        }
+
+
+        // Utility Functions
+
+        // Integer power by squaring, the result wraps around like repeated multiplication would
+        // A negative exponent gives the whole part of 1 / number^-exponent, which is 0 unless the number is 1 or -1
+        int power(int number, int exponent)
+        {
+            if (number == 1)
+            {
+                return 1;
             }
-            else if (realVariables.find(varName) != realVariables.end())
+            if (number == -1)
             {
-                variable.real = &realVariables[varName];
-                variable.type = REAL;
+                return exponent % 2 == 0 ? 1 : -1;
             }
-            else
+            if (exponent < 0 || number == 0)
+            {
+                return exponent == 0 ? 1 : 0;
+            }
+            if (number == 2)
+            {
+                return exponent < 32 ? (int)(1u << exponent) : 0;
+            }
+
+            // Unsigned multiplication wraps without undefined behavior
+            unsigned int result = 1, base = number;
+            while (exponent > 0)
+            {
+                if (exponent & 1)
+                {
+                    result *= base;
+                }
+                base *= base;
+                exponent >>= 1;
+            }
+            return (int)result;
+        }
+
+        // Move the cursor to the first character
+        void trim(std::string &str, int &position)
+        {
+            while (str[position] == ' ' && str[position] != '\0')
+            {
+                position++;
+            }
+        }
+
+        // Read the expression until the next space
+        void readUntilNextSpace(std::string &expr, int &position, std::string &temp)
+        {
+            char checkFor = ' ';
+            if (expr[position] == '\'')
+            {
+                checkFor = '\'';
+                temp += expr[position];
+                position++;
+            }
+            while (expr[position] != checkFor && expr[position] != '\0')
+            {
+                temp += expr[position];
+                position++;
+            }
+            if (checkFor == '\'' && expr[position] != '\0')
+            {
+                temp += expr[position];
+                position++;
+            }
+        }
+
+        // Check if the next expression exists (AND keyword)
+        int nextExpressionExists(std::string &expr, int &position)
+        {
+            return findKeyword(expr, position, AND);
+        }
+
+        // Find a specific keyword in the expression and move the cursor to the first character of the keyword
+        int findKeyword(std::string &expr, int &position, int keyword)
+        {
+            while (position < expr.length() - keywordsToString.at(keyword).length())
+            {
+                if (expr[position] == '\'')
+                {
+                    position++;
+                    while (expr[position] != '\'' && position < expr.length())
+                    {
+                        position++;
+                    }
+                    position++;
+                }
+                if (expr.substr(position, keywordsToString.at(keyword).length()) == keywordsToString.at(keyword))
+                {
+                    if ((position == 0 || expr[position - 1] == ' ') && (expr[position + keywordsToString.at(keyword).length()] == ' ' || expr[position + keywordsToString.at(keyword).length()] == '\0'))
+                        return true;
+                }
+                position++;
+            }
+            return false;
+        }
+
+        // Check if the token is a specific keyword
+        int isKeyword(Token &token, int keyword)
+        {
+            return token.type == KEYWORD_TOKEN && token.id == keyword;
+        }
+
+        // Check if the token ends a statement
+        int endsStatement(Token &token)
+        {
+            return isKeyword(token, AND) || closesBlock(token);
+        }
+
+        // Check if the token closes the block of an if or a while
+        int closesBlock(Token &token)
+        {
+            return isKeyword(token, ELSE) || isKeyword(token, STOP) || isKeyword(token, TILLHERE);
+        }
+
+
+        // Check if the std::string is a number
+        int isNumber(std::string &str)
+        {
+            int dotCount = 0;
+            for (int i = 0; i < str.length(); i++)
+            {
+                if (str[i] < '0' || str[i] > '9')
+                {
+                    if (str[i] == '-' && i == 0)
+                    {
+                        continue;
+                    }
+                    if (str[i] == '.' && dotCount == 0)
+                    {
+                        dotCount++;
+                        continue;
+                    }
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Check if the std::string is a std::string literal (Enclosed in double quotes)
+        int isString(std::string &str)
+        {
+            if (str[0] == '\'' && str[str.length() - 1] == '\'')
+            {
+                return true;
+            }
+            return false;
+        }
+
+        // Check if the std::string is a real number
+        int isReal(std::string &str)
+        {
+            int dotCount = 0;
+            for (int i = 0; i < str.length(); i++)
+            {
+                if (str[i] < '0' || str[i] > '9')
+                {
+                    if (str[i] == '-' && i == 0)
+                    {
+                        continue;
+                    }
+                    if (str[i] == '.' && dotCount == 0)
+                    {
+                        dotCount++;
+                        continue;
+                    }
+                    return false;
+                }
+            }
+            if (dotCount == 1)
+            {
+                return true;
+            }
+            return false;
+        }
+
+        // Validate the name of the variable
+        int validateName(std::string name)
+        {
+            // Name cannot be empty
+            if (name[0] == '\n')
+                return false;
+
+            // Name cannot start with a number
+            if (name[0] >= '0' && name[0] <= '0')
+                return false;
+
+            // Name can only contain alphabets and numbers
+            for (int i = 0; i < name.length(); i++)
+            {
+                if (name[i] >= '0' && name[i] <= '9')
+                    continue;
+                if (name[i] >= 'a' && name[i] <= 'z')
+                    continue;
+                if (name[i] >= 'A' && name[i] <= 'Z')
+                    continue;
+                return false;
+            }
+
+            // Name cannot be a reserved keyword
+            for (auto reserved : reservedWords)
+            {
+                if (name.compare(reserved) == 0)
+                    return false;
+            }
+            return true;
+        }
+
+        Multitype getVariable(std::string &varName)
+        {
+            // If the variable is an array
+            Multitype variable;
+            variable.type = -1;
+            if (varName.find('-') != std::string::npos)
+            {
+                // Seperate the name and index
+                std::string arrayName = varName.substr(0, varName.find('-'));
+                std::string indexString = varName.substr(varName.find('-') + 1);
+
+                int dummy = 0;
+                int index = solveForInteger(indexString, dummy);
+
+                // The arrays of a name are tried in the order integer, real, text
+                int identifier = findIdentifier(arrayName);
+                if (identifier == -1 || identifierArrays[identifier] == -1)
+                {
+                    return variable;
+                }
+                Array &array = arrays[identifierArrays[identifier]];
+                if (array.types & (1 << INTEGER_ARRAY))
+                {
+                    if (index >= 0 && index < array.integers.size())
+                    {
+                        variable.integer = &array.integers[index];
+                        variable.type = INTEGER;
+                    }
+
+                    // If the index is out of bounds
+                    else
+                    {
+                        printError(INDEX_OUT_OF_BOUNDS);
+                        exit(0);
+                    }
+                }
+                else if (array.types & (1 << REAL_ARRAY))
+                {
+                    if (index >= 0 && index < array.reals.size())
+                    {
+                        variable.real = &array.reals[index];
+                        variable.type = REAL;
+                    }
+                    else
+                    {
+                        printError(INDEX_OUT_OF_BOUNDS);
+                        exit(0);
+                    }
+                }
+                else if (array.types & (1 << TEXT_ARRAY))
+                {
+                    if (index >= 0 && index < array.texts.size())
+                    {
+                        variable.text = &array.texts[index];
+                        variable.type = TEXT;
+                    }
+                    else
+                    {
+                        printError(INDEX_OUT_OF_BOUNDS);
+                        exit(0);
+                    }
+                }
+                return variable;
+            }
+
+            // Integers come before texts and texts before reals
+            int identifier = findIdentifier(varName);
+            if (identifier == -1)
+            {
+                return variable;
+            }
+            Slot &slot = variables[identifier];
+            variable.integer = &slot.integer;
+            variable.real = &slot.real;
+            variable.text = &slot.text;
+            if (slot.types & (1 << INTEGER))
+            {
+                variable.type = INTEGER;
+            }
+            else if (slot.types & (1 << TEXT))
             {
-                variable.type = -1;
+                variable.type = TEXT;
+            }
+            else if (slot.types & (1 << REAL))
+            {
+                variable.type = REAL;
             }
             return variable;
         }
@@ -1516,7 +3147,7 @@ namespace symboless
 
                     // Store the code of the subroutine
                     std::vector<std::string> subroutineCode;
-                    while (getline(program, line))
+                    while (getline(partialyProcessedProgram, line))
                     {
                         if (line == keywordsToString.at(END))
                         {
@@ -1530,10 +3161,19 @@ namespace symboless
         }
 
     public:
-        Symboless(std::string __original, std::string input, std::string &output)
+        enum ENGINES
         {
-            // Store the newline character in the textVariables std::map
-            textVariables.insert({keywordsToString.at(NEWLINE), "\n"});
+            INTERPRETER_ENGINE,
+            VM_ENGINE
+        };
+
+        Symboless(std::string __original, std::string input, std::string &output, int engine = INTERPRETER_ENGINE)
+        {
+            // Store the newline character in its own variable
+            std::string newline = keywordsToString.at(NEWLINE);
+            Slot &variable = variables[internIdentifier(newline)];
+            variable.types = 1 << TEXT;
+            variable.text = "\n";
 
             originalScript = __original;
             // Preprocess the file
@@ -1541,8 +3181,27 @@ namespace symboless
             // Open the preprocessed file
             std::istringstream program(processedScript);
             inputStream.str(input);
-            // Interpret the program line by line
             std::string line;
+
+            // Compile the program with its subroutines and run it on the virtual machine
+            if (engine == VM_ENGINE)
+            {
+                std::vector<std::vector<Statement>> lines;
+                while (getline(program, line))
+                {
+                    std::vector<Token> tokens;
+                    tokenize(line, tokens);
+                    lines.push_back(std::vector<Statement>());
+                    parse(tokens, lines.back());
+                }
+                Bytecode bytecode;
+                compile(lines, bytecode);
+                run(bytecode);
+                output = outputStream.str();
+                return;
+            }
+
+            // Interpret the program line by line
             while (getline(program, line))
             {
                 currentLine++;
@@ -1551,4 +3210,4 @@ namespace symboless
             output = outputStream.str();
         }
     };
-}
\ No newline at end of file
+}
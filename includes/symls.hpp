@@ -1,9 +1,22 @@
 #pragma once
 // containers
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
+// For find() function
+#include <algorithm>
+
+// For INT_MAX
+#include <climits>
+
+// For DBL_MAX
+#include <cfloat>
+
+// For the fixed size integers of the cache files
+#include <cstdint>
+
 // For exit() function
 #include <stdlib.h>
 
@@ -16,9 +29,40 @@
 // For file handling
 #include <fstream>
 
+// For memcmp() and memchr() functions
+#include <cstring>
+
+// For the size and modification time of the configuration file
+#include <filesystem>
+
 // For JSON parsing
 #include <json.hpp>
 
+// For the vector kernels of the array reductions, chosen while running for the processor
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define SYMLS_X86_KERNELS
+#endif
+
+// For to_chars() function
+#include <charconv>
+
+// For errno
+#include <cerrno>
+
+// For the names of the temporary files where mkstemp() is not available
+#include <random>
+
+// For mapping the program file into memory, writing the output with write(), isatty() and mkstemp()
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SYMLS_MMAP
+#define SYMLS_POSIX_IO
+#endif
+
 typedef struct
 {
     int *integer;
@@ -27,23 +71,402 @@ typedef struct
     int type;
 } Multitype;
 
+// A single word of a preprocessed line
+// id is the keyword, operator or data type for those tokens and an index into
+// numberLiterals, textLiterals or identifierNames for the others
+typedef struct
+{
+    int type;
+    int id;
+} Token;
+
+// A reduction such as sum-of arr, a token of type REDUCTION_TOKEN is the index of one of these
+typedef struct
+{
+    int kind;
+    int identifier;
+} Reduction;
+
+// The kernels of the reductions, scalar ones until the processor is checked
+typedef struct
+{
+    int (*sumIntegers)(const int *values, size_t size);
+    int (*minimumInteger)(const int *values, size_t size);
+    int (*maximumInteger)(const int *values, size_t size);
+    double (*sumReals)(const double *values, size_t size);
+    double (*minimumReal)(const double *values, size_t size);
+    double (*maximumReal)(const double *values, size_t size);
+} ReductionKernels;
+
+// A number literal converted once when it is read, a number which does not fit a type is not valid for it
+// isReal decides how a condition starting with the number is compared
+typedef struct
+{
+    int integer;
+    double real;
+    int integerValid;
+    int realValid;
+    int isReal;
+} Number;
+
+// An expression of the tree walker in postfix order, the operands from left to right and then the operators from right to left
+// A missing last operand is a step of type -1
+typedef struct
+{
+    std::vector<Token> steps;
+
+    // Error raised once the operands are read if an operator can not be used, -1 if there is none
+    int error;
+
+    // Texts can only be joined, a text reads this many operands before raising an error, -1 if every operator is plus
+    int textOperands;
+} Postfix;
+
+// Condition of an if or a while, leftHalf is logic rightHalf
+typedef struct
+{
+    std::vector<Token> left;
+    int logic;
+    std::vector<Token> right;
+
+    // The halves in postfix order for the tree walker
+    Postfix leftPostfix;
+    Postfix rightPostfix;
+} Condition;
+
+// A parsed statement, the blocks of if and while are already separated
+struct Statement
+{
+    int type;
+
+    // Error to report when the statement is reached, -1 if there is none
+    int error;
+
+    // let: data type of the variable
+    int dataType;
+
+    // let and assignment: the variable, goto: the subroutine
+    Token target;
+
+    // let and assignment: the expression to solve, and the same expression in postfix order for the tree walker
+    std::vector<Token> value;
+    Postfix postfix;
+
+    // print and read: the values chained with then
+    std::vector<Token> items;
+
+    // if and while: the condition and the blocks
+    Condition condition;
+    std::vector<Statement> body;
+    std::vector<Statement> otherwise;
+};
+
+// A variable, constant or temporary value
+// A name can be declared with more than one data type, types has one bit for each of them
+typedef struct
+{
+    int types;
+    int integer;
+    double real;
+    std::string text;
+} Slot;
+
+// The values of an array, a name can be declared as more than one kind of array
+// types has one bit for each of them like the types of a slot
+typedef struct
+{
+    int types;
+    std::vector<int> integers;
+    std::vector<double> reals;
+    std::vector<std::string> texts;
+} Array;
+
+// An array element written as name-index, resolved to the handle of the array and the slot of the index
+// When the index is itself an element, index is -1 and element is the position of that element
+// An index which is not a valid number sets error, which is reported when the element is used
+typedef struct
+{
+    int array;
+    int index;
+    int element;
+    int error;
+} Element;
+
+// A keyword, operator or data type of the active configuration, word is nullptr for an empty entry of the recognizer
+typedef struct
+{
+    const std::string *word;
+    int type;
+    int id;
+} ReservedWord;
+
+// A bucket of the symbol table, the hash is kept so that probing rarely compares names
+typedef struct
+{
+    unsigned int hash;
+    int identifier;
+} SymbolBucket;
+
+// What the compiler proved about the array elements of a while loop
+typedef struct
+{
+    // Identifiers of i and n in while i is less-than n, bound is -1 when n is the number limit
+    int index;
+    int bound;
+    int limit;
+
+    // The most i grows by in one pass of the body
+    int step;
+
+    // Arrays declared inside the loop, arrays whose elements at i are proven and the tokens of those elements
+    std::vector<int> declared;
+    std::vector<int> arrays;
+    std::set<Token *> elements;
+} LoopBounds;
+
+// A subroutine, its lines are parsed once when the program is loaded
+typedef struct
+{
+    std::vector<std::vector<Statement>> lines;
+} Subroutine;
+
+// The bytes of a program file, mapped into memory or read into text where mapping is not available
+typedef struct
+{
+    const char *bytes;
+    size_t size;
+    int mapped;
+    std::string text;
+} SourceFile;
+
+// A line of the preprocessed program, tokenized straight from the bytes of the file
+// subroutine is the identifier of the name on a line defining a subroutine and -1 on the others
+// end is true on a line which is only the keyword END
+typedef struct
+{
+    std::vector<Token> tokens;
+    int subroutine;
+    int end;
+} SourceLine;
+
+// Header of a file caching the compiled form of a program, the code and the tables follow it
+// The offsets are multiples of 8, so that the code can be run from the mapped file without copying it
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t integerSize;
+    uint64_t key;
+    uint64_t codeOffset;
+    uint64_t codeSize;
+    uint64_t tablesOffset;
+    uint64_t tablesSize;
+} CacheHeader;
+
+// Start of a configuration snapshot, which is followed by the value of every configuration field as a text
+// The snapshot is used while the configuration file has the same modification time and size, or the same hash
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t fields;
+    int64_t modified;
+    uint64_t size;
+    uint64_t hash;
+} SnapshotHeader;
+
+// A value of the configuration, its path in the configuration file, what it sets and its built in value
+// The built in value is used when the configuration file does not have the field
+typedef struct
+{
+    const char *path[3];
+    int kind;
+    int setting;
+    const char *value;
+} ConfigField;
+
+// Compiled form of a program for the virtual machine
+// Instructions and their operands are stored one after the other in code
+typedef struct
+{
+    std::vector<int> code;
+
+    // Operands of the calls which wait for the address of their subroutine
+    std::vector<std::pair<int, int>> calls;
+} Bytecode;
+
 // Functions for solving expressions
-int solveForInteger(std::string &expr, int &position);
-std::string solveForText(std::string &expr, int &position);
-double solveForReal(std::string &expr, int &position);
-int checkIntegralCondition(std::string &expr);
-int checkTextCondition(std::string &expr);
-int checkRealCondition(std::string &expr);
-int checkCondition(std::string &expr);
+int solveForInteger(Postfix &expr);
+std::string solveForText(Postfix &expr);
+double solveForReal(Postfix &expr);
+int integerOperand(Token &operand);
+std::string &textOperand(Token &operand);
+double realOperand(Token &operand);
+int checkIntegralCondition(Condition &condition);
+int checkTextCondition(Condition &condition);
+int checkRealCondition(Condition &condition);
+int checkCondition(Condition &condition);
 
 // Functions for interpreting the code
-void interpret(std::string &expr);
-void initiate(std::string &expr);
-void printOutput(std::string &expr, int &position);
-void readFromUser(std::string &expr, int &position);
+int interpret(std::vector<Statement> &statements);
+int interpret(Statement &statement);
+void initiate(Statement &statement);
+void printOutput(Statement &statement);
+void readFromUser(Statement &statement);
 void printError(int errCode);
 void endProgram();
 
+// Functions for writing the output
+void outputBytes(const char *bytes, size_t size);
+void outputText(const std::string &text);
+void outputInteger(int value);
+void outputReal(double value);
+void flushOutput();
+void flushForInput();
+void writeOutput(const char *bytes, size_t size);
+int printArray(Array &array);
+
+// Functions for reading the input
+int peekInput();
+int refillInput();
+int skipSpaces();
+int inputInteger(int &value);
+int inputReal(double &value);
+int inputText(std::string &text);
+int inputLine(std::string &line);
+int readArray(Array &array);
+
+// Functions for tokenizing the code
+void tokenize(std::string &line, std::vector<Token> &tokens);
+Token classifyWord(std::string &word);
+int recognizeWord(const char *bytes, size_t length, Token &token);
+void buildRecognizer();
+void addReservedWord(ReservedWord words[], int &count, const std::string &word, int type, int id);
+unsigned int hashWord(const char *bytes, size_t length, unsigned int seed);
+int internIdentifier(std::string &name);
+int findIdentifier(std::string &name);
+unsigned int hashName(std::string &name);
+int internNumber(std::string &word);
+
+// Functions for parsing the code
+void parse(std::vector<Token> &tokens, std::vector<Statement> &statements);
+void parseBlock(std::vector<Token> &tokens, size_t &position, std::vector<Statement> &statements);
+Statement parseStatement(std::vector<Token> &tokens, size_t &position);
+void parseCondition(std::vector<Token> &tokens, size_t &position, int closing, Condition &condition);
+void readExpression(std::vector<Token> &tokens, size_t &position, std::vector<Token> &expr);
+void skipStatement(std::vector<Token> &tokens, size_t &position);
+Statement newStatement(int type);
+
+// Functions for resolving the variables
+void resolve(std::vector<Statement> &statements);
+void resolve(Token &token);
+void checkCalls(std::vector<Statement> &statements, int line);
+int slotOf(int identifier);
+int newSlot(int types);
+int arrayOf(int identifier);
+int elementOf(int identifier);
+void foldConstants(std::vector<Token> &expr);
+void toPostfix(std::vector<Token> &expr, Postfix &postfix);
+int foldNumbers(Number &left, int op, Number &right, Number &result);
+
+// Functions for inlining the subroutines
+void inlineSubroutines(std::vector<std::vector<Statement>> &lines);
+void inlineCalls(std::vector<Statement> &statements, std::vector<std::vector<Statement>> &bodies, std::vector<int> &inlined, std::string site);
+int countStatements(std::vector<Statement> &statements);
+int leavesBlock(std::vector<Statement> &statements);
+
+// Functions for compiling the code
+void compile(std::vector<std::vector<Statement>> &lines, Bytecode &bytecode);
+void compileBlock(std::vector<Statement> &statements, Bytecode &bytecode);
+void compileStatement(Statement &statement, Bytecode &bytecode);
+void compileLoop(Statement &statement, Bytecode &bytecode);
+void compileCondition(Condition &condition, std::vector<int> &exits, Bytecode &bytecode);
+void compileComparison(Condition &condition, int type, std::vector<int> &exits, Bytecode &bytecode);
+int compileExpression(std::vector<Token> &expr, int type, int destination, Bytecode &bytecode);
+int operatorInstruction(Token &op, int type);
+int compileOperand(Token &operand, int type, Bytecode &bytecode);
+int compileIndex(std::string word, Bytecode &bytecode);
+int constantCondition(Condition &condition, int type);
+void collectTypes(std::vector<Statement> &statements);
+int baseOf(int identifier);
+int staticType(Token &token);
+int proveBounds(Statement &loop, LoopBounds &bounds);
+int scanLoop(std::vector<Statement> &statements, LoopBounds &bounds, int nested);
+void collectElements(std::vector<Statement> &statements, LoopBounds &bounds, int &unmodified);
+void markElement(Token &token, LoopBounds &bounds);
+int constantSlot(int value);
+int constantSlot(double value);
+int constantSlot(std::string value);
+int zeroSlot(int type);
+int temporarySlot(int type);
+int emit(Bytecode &bytecode, int instruction);
+int emit(Bytecode &bytecode, int instruction, int first);
+int emit(Bytecode &bytecode, int instruction, int first, int second);
+int emit(Bytecode &bytecode, int instruction, int first, int second, int third);
+int emit(Bytecode &bytecode, int instruction, int first, int second, int third, int fourth);
+int emitCases(Bytecode &bytecode);
+void patch(Bytecode &bytecode, int operand);
+
+// Functions for caching the compiled code
+std::string cachePath(std::string fileName);
+unsigned long long cacheKey(std::string fileName);
+unsigned long long hashBytes(const char *bytes, size_t size, unsigned long long hash);
+const int *loadCache(std::string path, unsigned long long key, SourceFile &cache);
+void saveCache(std::string path, unsigned long long key, Bytecode &bytecode);
+const char *operandsOf(int instruction);
+int checkCode(const int *code, size_t size, size_t slotCount, size_t arrayCount, size_t literalCount, std::map<int, std::string> &messages);
+void writeInteger(std::string &tables, long long value);
+void writeReal(std::string &tables, double value);
+void writeText(std::string &tables, const std::string &text);
+long long readInteger(const char *&cursor, const char *end, int &valid);
+double readReal(const char *&cursor, const char *end, int &valid);
+std::string readText(const char *&cursor, const char *end, int &valid);
+void replaceFile(std::string path, const std::string &bytes);
+
+// Functions for reducing arrays
+void combineReductions(std::vector<Token> &tokens);
+int elementType(Array &array);
+int reductionType(int kind, Array &array);
+int integerReduction(int kind, Array &array);
+double realReduction(int kind, Array &array);
+void printReduction(int kind, Array &array);
+void selectKernels();
+int sumIntegersScalar(const int *values, size_t size);
+int minimumIntegerScalar(const int *values, size_t size);
+int maximumIntegerScalar(const int *values, size_t size);
+double sumRealsScalar(const double *values, size_t size);
+double minimumRealScalar(const double *values, size_t size);
+double maximumRealScalar(const double *values, size_t size);
+double combineLanes(int kind, const double lanes[8], const double *values, size_t start, size_t size);
+#ifdef SYMLS_X86_KERNELS
+int sumIntegersSse(const int *values, size_t size);
+int minimumIntegerSse(const int *values, size_t size);
+int maximumIntegerSse(const int *values, size_t size);
+double sumRealsSse(const double *values, size_t size);
+double minimumRealSse(const double *values, size_t size);
+double maximumRealSse(const double *values, size_t size);
+int sumIntegersAvx2(const int *values, size_t size);
+int minimumIntegerAvx2(const int *values, size_t size);
+int maximumIntegerAvx2(const int *values, size_t size);
+double sumRealsAvx2(const double *values, size_t size);
+double minimumRealAvx2(const double *values, size_t size);
+double maximumRealAvx2(const double *values, size_t size);
+#endif
+
+// Functions for running the compiled code
+void run(const int *code);
+int typeOf(Slot &slot);
+int integerValue(Slot &slot);
+double realValue(Slot &slot);
+std::string &textValue(Slot &slot);
+int &integerTarget(Slot &slot);
+double &realTarget(Slot &slot);
+std::string &textTarget(Slot &slot);
+Multitype getElement(int array, int index);
+Multitype uncheckedElement(int array, int index);
+Multitype getElement(Element &element);
+int elementIndex(Element &element);
+
 // Utility functions
 void trim(std::string &str, int &position);
 int power(int number, int exponent);
@@ -51,22 +474,105 @@ int isNumber(std::string &str);
 int isString(std::string &str);
 int isReal(std::string &str);
 void readUntilNextSpace(std::string &expr, int &position, std::string &temp);
-int nextExpressionExists(std::string &expr, int &position);
-int findKeyword(std::string &expr, int &position, int keyword);
+void readWord(const char *&cursor, const char *end, std::string &word);
+int isKeyword(Token &token, int keyword);
+int endsStatement(Token &token);
+int closesBlock(Token &token);
 int validateName(std::string name);
-Multitype getVariable(std::string varName);
+Multitype getVariable(Token &token);
+Multitype getVariable(Slot &slot);
 
 // Loading and preprocessing functions
-void preprocess(std::string fileName);
+int openSource(std::string fileName, SourceFile &file);
+void closeSource(SourceFile &file);
+int preprocess(std::string fileName, std::vector<SourceLine> &lines);
 void configure();
+void openStreams();
+
+// Functions for the configuration snapshot
+int loadSnapshot(long long modified, unsigned long long size, const unsigned long long *hash, std::vector<std::string> &values);
+void saveSnapshot(long long modified, unsigned long long size, unsigned long long hash, std::vector<std::string> &values);
+void readConfiguration(std::string &configurations, std::vector<std::string> &values);
+void applyConfiguration(std::vector<std::string> &values);
+
+// Subroutines in the order they are defined, goto finds them through the identifier of their name
+std::vector<Subroutine> subroutines;
+
+// Slots of the variables used by both engines, constants and temporaries of the virtual machine
+std::vector<Slot> slots;
+std::vector<Array> arrays;
+std::vector<Element> elements;
+
+// Element tokens of the loop being compiled which are proven to be in bounds
+std::set<Token *> uncheckedElements;
+
+// Off while the copy of a loop without bounds checks is compiled, the loops inside it are compiled once
+int versionLoops = true;
+
+// Value stacks of the tree walker, as deep as the longest expression
+std::vector<int> integerStack;
+std::vector<double> realStack;
+std::vector<std::string> textStack;
+
+// Jumps of the escape and recheck statements in the loop being compiled and in the loops around it
+// They are patched to the end of the loop and to its condition, outside of a loop to the end of the line
+std::vector<std::vector<int>> escapeJumps;
+std::vector<std::vector<int>> recheckJumps;
+
+// Temporary slots of each data type and how many of them the statement being compiled uses
+std::vector<int> temporarySlots[3];
+int temporariesUsed[3];
+
+// Output of the program waiting to be written, it is flushed when it fills up, before reading from a terminal and at the end
+const int OUTPUT_BUFFER_SIZE = 1 << 16;
+char outputBuffer[OUTPUT_BUFFER_SIZE];
+int outputSize = 0;
+int interactiveInput = true;
+
+// Input waiting to be read, from inputStart to inputEnd, and the digits of the real being read
+// inputFailed is set once a value can not be read, after that nothing more is read
+const int INPUT_BUFFER_SIZE = 1 << 16;
+char inputBuffer[INPUT_BUFFER_SIZE];
+size_t inputStart = 0, inputEnd = 0;
+int inputEnded = false, inputFailed = false;
+std::string inputToken;
+
+// Powers of ten which are exact as doubles, a real with few digits is converted with one of them
+const double POWERS_OF_TEN[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+// Perfect hash of the reserved words of the active configuration, built again after the configuration changes
+// Seeds are tried until every word has an entry of its own, so a word is recognized with a single probe
+const int RECOGNIZER_SIZE = 256;
+ReservedWord recognizer[RECOGNIZER_SIZE];
+unsigned int recognizerSeed = 0;
+int recognizerBuilt = false;
+
+// Reductions written in the program, the array of each is found through the identifier of its name
+std::vector<Reduction> reductions;
+ReductionKernels kernels = {sumIntegersScalar, minimumIntegerScalar, maximumIntegerScalar, sumRealsScalar, minimumRealScalar, maximumRealScalar};
+int kernelsSelected = false;
+
+// Symbol table, open addressing from the names to their identifiers, empty buckets have the identifier -1
+// For every identifier its name, its slot, its array, the element it names and the subroutine it names are kept
+// Each is -1 until the name is resolved, compiled or defined as such, names with '-' in them never get a slot
+std::vector<SymbolBucket> symbolTable;
+std::vector<std::string> identifierNames;
+std::vector<int> identifierSlots;
+std::vector<int> identifierArrays;
+std::vector<int> identifierElements;
+std::vector<int> identifierSubroutines;
+
+// The identifier of the array a name like arr-i refers to, -1 until it is first needed
+// A name without '-' refers to itself
+std::vector<int> identifierBases;
 
-std::map<std::string, int> integerVariables;
-std::map<std::string, std::string> textVariables;
-std::map<std::string, double> realVariables;
-std::map<std::string, std::vector<int>> integerArrays;
-std::map<std::string, std::vector<std::string>> textArrays;
-std::map<std::string, std::vector<double>> realArrays;
-std::map<std::string, std::vector<std::string>> subroutines;
+// Types every variable and array is declared with anywhere in the program, one bit per data type
+std::vector<int> identifierTypes;
+
+// Literals referred to by the tokens, numbers holds the converted value of each number literal
+std::vector<std::string> numberLiterals;
+std::vector<Number> numbers;
+std::vector<std::string> textLiterals;
 
 enum DATA_TYPES
 {
@@ -113,7 +619,173 @@ enum KEYWORDS
     NEWLINE,
     LEAVE,
     END,
-    SUBROUTINE
+    SUBROUTINE,
+
+    // Reductions of a whole array, used like a variable in an expression
+    SUM_OF,
+    MINIMUM_OF,
+    MAXIMUM_OF,
+    COUNT_OF
+};
+
+enum TOKEN_TYPES
+{
+    KEYWORD_TOKEN,
+    OPERATOR_TOKEN,
+    DATA_TYPE_TOKEN,
+    NUMBER_TOKEN,
+    STRING_TOKEN,
+    IDENTIFIER_TOKEN,
+    REDUCTION_TOKEN
+};
+
+enum STATEMENT_TYPES
+{
+    LET_STATEMENT,
+    ASSIGN_STATEMENT,
+    PRINT_STATEMENT,
+    READ_STATEMENT,
+    IF_STATEMENT,
+    WHILE_STATEMENT,
+    GOTO_STATEMENT,
+    ESCAPE_STATEMENT,
+    RECHECK_STATEMENT,
+    END_STATEMENT,
+    SKIP_STATEMENT,
+    INVALID_STATEMENT
+};
+
+enum INSTRUCTIONS
+{
+    // Three operand arithmetic, the operands are slots in the order target, left, right
+    ADD_INTEGER,
+    SUBTRACT_INTEGER,
+    DIVIDE_INTEGER,
+    MULTIPLY_INTEGER,
+    MODULO_INTEGER,
+    POWER_INTEGER,
+    ADD_REAL,
+    SUBTRACT_REAL,
+    DIVIDE_REAL,
+    MULTIPLY_REAL,
+    MODULO_REAL,
+    POWER_REAL,
+    JOIN_TEXT,
+
+    // Copy the second slot into the first, DECLARE also gives the variable the type
+    MOVE_INTEGER,
+    MOVE_REAL,
+    MOVE_TEXT,
+    DECLARE_INTEGER,
+    DECLARE_REAL,
+    DECLARE_TEXT,
+
+    // Create the array named by the identifier with the size in the slot
+    DECLARE_INTEGER_ARRAY,
+    DECLARE_REAL_ARRAY,
+    DECLARE_TEXT_ARRAY,
+
+    // Array elements, the array is an identifier and the index a slot
+    LOAD_INTEGER_ELEMENT,
+    LOAD_REAL_ELEMENT,
+    LOAD_TEXT_ELEMENT,
+    STORE_INTEGER_ELEMENT,
+    STORE_REAL_ELEMENT,
+    STORE_TEXT_ELEMENT,
+
+    // Array elements a loop has proven to be in bounds, the index slot holds an integer
+    LOAD_INTEGER_ELEMENT_UNCHECKED,
+    LOAD_REAL_ELEMENT_UNCHECKED,
+    LOAD_TEXT_ELEMENT_UNCHECKED,
+    STORE_INTEGER_ELEMENT_UNCHECKED,
+    STORE_REAL_ELEMENT_UNCHECKED,
+    STORE_TEXT_ELEMENT_UNCHECKED,
+
+    // Compare two slots and jump to the address when the condition is false
+    JUMP_UNLESS_LESS_INTEGER,
+    JUMP_UNLESS_GREATER_INTEGER,
+    JUMP_UNLESS_EQUAL_INTEGER,
+    JUMP_UNLESS_NOT_EQUAL_INTEGER,
+    JUMP_UNLESS_LESS_REAL,
+    JUMP_UNLESS_GREATER_REAL,
+    JUMP_UNLESS_EQUAL_REAL,
+    JUMP_UNLESS_NOT_EQUAL_REAL,
+    JUMP_UNLESS_LESS_TEXT,
+    JUMP_UNLESS_GREATER_TEXT,
+    JUMP_UNLESS_EQUAL_TEXT,
+    JUMP_UNLESS_NOT_EQUAL_TEXT,
+
+    // Control flow, the operands are addresses in the code
+    JUMP,
+    SWITCH_TYPE,
+    SWITCH_ELEMENT_TYPE,
+    JUMP_UNLESS_COVERED,
+    CALL,
+    RETURN,
+
+    // Input and output
+    PRINT_LITERAL,
+    PRINT_VARIABLE,
+    PRINT_ELEMENT,
+    PRINT_ELEMENT_UNCHECKED,
+    PRINT_ARRAY,
+    READ_VARIABLE,
+    READ_ELEMENT,
+    READ_ELEMENT_UNCHECKED,
+    READ_ARRAY,
+
+    // Array reductions
+    REDUCE_INTEGER,
+    REDUCE_REAL,
+    SWITCH_REDUCTION_TYPE,
+    PRINT_REDUCTION,
+
+    // Bookkeeping
+    CHECK_VARIABLE,
+    CHECK_ELEMENT,
+    CHECK_OPERAND,
+    NEXT_LINE,
+    RAISE,
+    HALT
+};
+
+// How the tree walker leaves a block, escape and recheck skip the rest of it
+enum FLOWS
+{
+    NEXT_FLOW,
+    ESCAPE_FLOW,
+    RECHECK_FLOW
+};
+
+// What a configuration field sets, the keyword, data type, operator or error it names is its setting
+enum CONFIG_KINDS
+{
+    OPTION_CONFIG,
+    KEYWORD_CONFIG,
+    DATATYPE_CONFIG,
+    MATH_CONFIG,
+    LOGIC_CONFIG,
+    ERROR_CONFIG
+};
+
+enum OPTIONS
+{
+    INPUT_FILE,
+    OUTPUT_FILE,
+    ERROR_FILE,
+    PREPROCESSED_FILE,
+    ARRAY_SIZE,
+    INTEGER_VALUE,
+    REAL_VALUE,
+    TEXT_VALUE,
+    ARRAY_SEPARATOR_OPTION,
+    INLINE_SIZE_OPTION
+};
+
+enum ENGINES
+{
+    TREE_ENGINE,
+    VM_ENGINE
 };
 
 enum ERRORS
@@ -123,17 +795,96 @@ enum ERRORS
     INVALID_OPERATOR,
     VARIABLE_NOT_FOUND,
     INDEX_OUT_OF_BOUNDS,
-    INVALID_NAME
+    INVALID_NAME,
+    SUBROUTINE_NOT_FOUND
 };
 
+// Cache files of another version are compiled again, it changes whenever the compiled form does
+const uint32_t CACHE_VERSION = 2;
+const char CACHE_MAGIC[8] = {'S', 'Y', 'M', 'L', 'S', 'C', '\0', '\0'};
+const uint32_t SNAPSHOT_VERSION = 1;
+const char SNAPSHOT_MAGIC[8] = {'S', 'Y', 'M', 'L', 'S', 'C', 'F', 'G'};
+
+// Every value read from the configuration file, in the order they are stored in the snapshot
+const ConfigField configFields[] = {
+    {{"io", "inputFile"}, OPTION_CONFIG, INPUT_FILE, "stdin"},
+    {{"io", "outputFile"}, OPTION_CONFIG, OUTPUT_FILE, "stdout"},
+    {{"io", "errorFile"}, OPTION_CONFIG, ERROR_FILE, "stderr"},
+    {{"io", "preProcessedFile"}, OPTION_CONFIG, PREPROCESSED_FILE, "processed_program.symls"},
+    {{"keywords", "let"}, KEYWORD_CONFIG, LET, "let"},
+    {{"keywords", "is"}, KEYWORD_CONFIG, IS, "is"},
+    {{"keywords", "if"}, KEYWORD_CONFIG, IF, "if"},
+    {{"keywords", "else"}, KEYWORD_CONFIG, ELSE, "else"},
+    {{"keywords", "then"}, KEYWORD_CONFIG, THEN, "then"},
+    {{"keywords", "skip"}, KEYWORD_CONFIG, SKIP, "skip"},
+    {{"keywords", "stop"}, KEYWORD_CONFIG, STOP, "stop"},
+    {{"keywords", "do"}, KEYWORD_CONFIG, DO, "do"},
+    {{"keywords", "while"}, KEYWORD_CONFIG, WHILE, "while"},
+    {{"keywords", "escape"}, KEYWORD_CONFIG, ESCAPE, "escape"},
+    {{"keywords", "recheck"}, KEYWORD_CONFIG, RECHECK, "recheck"},
+    {{"keywords", "tillhere"}, KEYWORD_CONFIG, TILLHERE, "till-here"},
+    {{"keywords", "and"}, KEYWORD_CONFIG, AND, "and"},
+    {{"keywords", "goto"}, KEYWORD_CONFIG, GOTO, "goto"},
+    {{"keywords", "read"}, KEYWORD_CONFIG, READ, "read"},
+    {{"keywords", "print"}, KEYWORD_CONFIG, PRINT, "print"},
+    {{"keywords", "newline"}, KEYWORD_CONFIG, NEWLINE, "newline"},
+    {{"keywords", "leave"}, KEYWORD_CONFIG, LEAVE, "leave"},
+    {{"keywords", "end"}, KEYWORD_CONFIG, END, "end"},
+    {{"keywords", "subroutine"}, KEYWORD_CONFIG, SUBROUTINE, "subroutine"},
+    {{"keywords", "sumOf"}, KEYWORD_CONFIG, SUM_OF, "sum-of"},
+    {{"keywords", "minimumOf"}, KEYWORD_CONFIG, MINIMUM_OF, "minimum-of"},
+    {{"keywords", "maximumOf"}, KEYWORD_CONFIG, MAXIMUM_OF, "maximum-of"},
+    {{"keywords", "countOf"}, KEYWORD_CONFIG, COUNT_OF, "count-of"},
+    {{"datatypes", "integer"}, DATATYPE_CONFIG, INTEGER, "integer"},
+    {{"datatypes", "text"}, DATATYPE_CONFIG, TEXT, "text"},
+    {{"datatypes", "real"}, DATATYPE_CONFIG, REAL, "real"},
+    {{"datatypes", "integerArray"}, DATATYPE_CONFIG, INTEGER_ARRAY, "integer-array"},
+    {{"datatypes", "textArray"}, DATATYPE_CONFIG, TEXT_ARRAY, "text-array"},
+    {{"datatypes", "realArray"}, DATATYPE_CONFIG, REAL_ARRAY, "real-array"},
+    {{"operators", "math", "plus"}, MATH_CONFIG, PLUS, "plus"},
+    {{"operators", "math", "minus"}, MATH_CONFIG, MINUS, "minus"},
+    {{"operators", "math", "into"}, MATH_CONFIG, INTO, "into"},
+    {{"operators", "math", "upon"}, MATH_CONFIG, UPON, "upon"},
+    {{"operators", "math", "modulo"}, MATH_CONFIG, MODULO, "modulo"},
+    {{"operators", "math", "exponent"}, MATH_CONFIG, EXPONENT, "exponent"},
+    {{"operators", "logic", "equals"}, LOGIC_CONFIG, EQUAL_TO, "equal-to"},
+    {{"operators", "logic", "notEquals"}, LOGIC_CONFIG, NOT_EQUAL_TO, "not-equal-to"},
+    {{"operators", "logic", "greaterThan"}, LOGIC_CONFIG, GREATER_THAN, "greater-than"},
+    {{"operators", "logic", "lessThan"}, LOGIC_CONFIG, LESS_THAN, "less-than"},
+    {{"errorMessages", "invalidSyntax"}, ERROR_CONFIG, INVALID_SYNTAX, "Invalid syntax"},
+    {{"errorMessages", "invalidDatatype"}, ERROR_CONFIG, INVALID_DATA_TYPE, "Invalid data type"},
+    {{"errorMessages", "invalidOperator"}, ERROR_CONFIG, INVALID_OPERATOR, "Invalid operator"},
+    {{"errorMessages", "indexOutOfBounds"}, ERROR_CONFIG, INDEX_OUT_OF_BOUNDS, "Index out of bounds"},
+    {{"errorMessages", "invalidVariableName"}, ERROR_CONFIG, INVALID_NAME, "Invalid name"},
+    {{"errorMessages", "variableNotFound"}, ERROR_CONFIG, VARIABLE_NOT_FOUND, "Variable not found"},
+    {{"errorMessages", "subroutineNotFound"}, ERROR_CONFIG, SUBROUTINE_NOT_FOUND, "Subroutine not found"},
+    {{"defaults", "arraySize"}, OPTION_CONFIG, ARRAY_SIZE, "64"},
+    {{"defaults", "integerValue"}, OPTION_CONFIG, INTEGER_VALUE, "0"},
+    {{"defaults", "realValue"}, OPTION_CONFIG, REAL_VALUE, "0.0"},
+    {{"defaults", "textValue"}, OPTION_CONFIG, TEXT_VALUE, ""},
+    {{"defaults", "arraySeparator"}, OPTION_CONFIG, ARRAY_SEPARATOR_OPTION, " "},
+    {{"optimizations", "inlineSize"}, OPTION_CONFIG, INLINE_SIZE_OPTION, "8"}};
+const int CONFIG_FIELDS = sizeof(configFields) / sizeof(configFields[0]);
+
 // Default configuration
+// The preprocessed program is written to preprocessedFileName only with --dump-preprocessed
 std::string preprocessedFileName = "processed_program.symls";
 const std::string configFileName = "symlsConfig.json";
+const std::string snapshotFileName = "symlsConfig.snapshot";
+std::string inputFileName = "stdin";
+std::string outputFileName = "stdout";
+std::string errorFileName = "stderr";
 int DEFAULT_ARRAY_SIZE = 64;
 int DEFAULT_INTEGER_VALUE = 0;
 std::string DEFAULT_TEXT_VALUE = "";
 double DEFAULT_REAL_VALUE = 0.0;
-std::vector<std::string> reservedWords = {"let", "is", "if", "else", "then", "skip", "stop", "do", "while", "escape", "recheck", "till-here", "and", "goto", "read", "print", "newline", "leave", "end", "subroutine", "plus", "minus", "upon", "into", "modulo", "exponent", "less-than", "greater-than", "equal-to", "not-equal-to", "integer", "text", "real", "integer-array", "text-array", "real-array"};
+
+// Printed between the elements of an array printed as a whole
+std::string ARRAY_SEPARATOR = " ";
+
+// Subroutines of at most this many statements are copied into their calls
+int INLINE_SIZE = 8;
+std::vector<std::string> reservedWords = {"let", "is", "if", "else", "then", "skip", "stop", "do", "while", "escape", "recheck", "till-here", "and", "goto", "read", "print", "newline", "leave", "end", "subroutine", "sum-of", "minimum-of", "maximum-of", "count-of", "plus", "minus", "upon", "into", "modulo", "exponent", "less-than", "greater-than", "equal-to", "not-equal-to", "integer", "text", "real", "integer-array", "text-array", "real-array"};
 
 std::map<std::string, int> mathOperators = {
     {"plus", PLUS},
@@ -193,7 +944,11 @@ std::map<int, std::string> keywordsToString = {
     {NEWLINE, "newline"},
     {LEAVE, "leave"},
     {END, "end"},
-    {SUBROUTINE, "subroutine"}};
+    {SUBROUTINE, "subroutine"},
+    {SUM_OF, "sum-of"},
+    {MINIMUM_OF, "minimum-of"},
+    {MAXIMUM_OF, "maximum-of"},
+    {COUNT_OF, "count-of"}};
 
 std::map<std::string, int> keywords = {
     {"let", LET},
@@ -215,7 +970,11 @@ std::map<std::string, int> keywords = {
     {"newline", NEWLINE},
     {"leave", LEAVE},
     {"end", END},
-    {"subroutine", SUBROUTINE}};
+    {"subroutine", SUBROUTINE},
+    {"sum-of", SUM_OF},
+    {"minimum-of", MINIMUM_OF},
+    {"maximum-of", MAXIMUM_OF},
+    {"count-of", COUNT_OF}};
 
 std::map<int, std::string> errorMassage = {
     {INVALID_SYNTAX, "Invalid syntax"},
@@ -223,4 +982,5 @@ std::map<int, std::string> errorMassage = {
     {INVALID_OPERATOR, "Invalid operator"},
     {VARIABLE_NOT_FOUND, "Variable not found"},
     {INDEX_OUT_OF_BOUNDS, "Index out of bounds"},
-    {INVALID_NAME, "Invalid name"}};
+    {INVALID_NAME, "Invalid name"},
+    {SUBROUTINE_NOT_FOUND, "Subroutine not found"}};
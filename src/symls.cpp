@@ -5,57 +5,189 @@
 using namespace std;
 
 // Status variables
-int currentLine = 0, escape = 0, recheckCondition = 0;
-ifstream program;
+int currentLine = 0;
+int engine = TREE_ENGINE;
+int inlining = 1, inlineReport = 0, dumpPreprocessed = 0;
+int caching = 0;
+string cacheDirectory = "";
 
 int main(int argc, char *argv[])
 {
+    // Read the options and the file name from the command line
+    string fileName = "";
+    for (int i = 1; i < argc; i++)
+    {
+        string argument = argv[i];
+        if (argument.compare(0, 9, "--engine=") == 0)
+        {
+            string engineName = argument.substr(9);
+            if (engineName.compare("tree") == 0)
+            {
+                engine = TREE_ENGINE;
+            }
+            else if (engineName.compare("vm") == 0)
+            {
+                engine = VM_ENGINE;
+            }
+            else
+            {
+                cout << "Unknown engine : " << engineName << endl;
+                return 0;
+            }
+        }
+        else if (argument.compare("--no-inline") == 0)
+        {
+            inlining = 0;
+        }
+        else if (argument.compare("--inline-report") == 0)
+        {
+            inlineReport = 1;
+        }
+        else if (argument.compare("--dump-preprocessed") == 0)
+        {
+            dumpPreprocessed = 1;
+        }
+        else if (argument.compare("--cache") == 0)
+        {
+            caching = 1;
+        }
+        else if (argument.compare(0, 12, "--cache-dir=") == 0)
+        {
+            caching = 1;
+            cacheDirectory = argument.substr(12);
+        }
+        else
+        {
+            fileName = argument;
+        }
+    }
+
+    // If the file name is entered withput extension
+    if (!fileName.empty() && fileName.find(".symls") == string::npos)
+    {
+        fileName.append(".symls");
+    }
+
+    // A program compiled before from the same source and configuration runs straight from its cache
+    // The configuration is not read and nothing is preprocessed or compiled
+    string cacheFile = "";
+    unsigned long long key = 0;
+    if (caching && engine == VM_ENGINE && !fileName.empty())
+    {
+        cacheFile = cachePath(fileName);
+        key = cacheKey(fileName);
+        SourceFile cache;
+        const int *code = loadCache(cacheFile, key, cache);
+        if (code != nullptr)
+        {
+            openStreams();
+            run(code);
+            endProgram();
+        }
+    }
+
     // Load the configuration from symlsConfig.json
     configure();
 
-    // Store the newline character in the textVariables map
-    textVariables.insert({keywordsToString.at(NEWLINE), "\n"});
+    // Store the newline character in its own slot
+    Slot &newline = slots[slotOf(internIdentifier(keywordsToString.at(NEWLINE)))];
+    newline.types = 1 << TEXT;
+    newline.text = "\n";
 
     // If the file name is not provided from command line
-    if (argc < 2)
+    if (fileName.empty())
     {
         string line;
-        while (getline(cin, line))
+        while (inputLine(line))
         {
-            currentLine++;
-            interpret(line);
-            cout<<endl;
+            vector<Token> tokens;
+            vector<Statement> statements;
+            tokenize(line, tokens);
+            parse(tokens, statements);
+            resolve(statements);
+
+            // The line is counted by the engine which runs it, its calls are checked as the next line
+            checkCalls(statements, currentLine + 1);
+            if (engine == VM_ENGINE)
+            {
+                // The compiled line moves to the next line number by itself
+                vector<vector<Statement>> lines = {statements};
+                Bytecode bytecode;
+                compile(lines, bytecode);
+                run(bytecode.code.data());
+            }
+            else
+            {
+                currentLine++;
+                interpret(statements);
+            }
+            outputText("\n");
+            flushForInput();
         }
+        flushOutput();
         return 0;
     }
 
-    string fileName = argv[1];
+    // Tokenize the file straight from memory
+    vector<SourceLine> sourceLines;
+    if (!preprocess(fileName, sourceLines))
+    {
+        cout << "File not found" << endl;
+        return 0;
+    }
 
-    // If the file name is entered withput extension
-    if (fileName.find(".symls") == string::npos)
+    // Parse the whole program once so that no line is scanned again while running
+    vector<vector<Statement>> lines;
+    for (auto &line : sourceLines)
     {
-        fileName.append(".symls");
+        lines.push_back(vector<Statement>());
+        parse(line.tokens, lines.back());
+    }
+
+    // Small subroutines are copied into their calls, so that the passes below see through them
+    if (inlining)
+    {
+        inlineSubroutines(lines);
     }
 
-    // Preprocess the file
-    preprocess(fileName);
+    // Give every variable of the program and its subroutines a slot
+    for (auto &statements : lines)
+    {
+        resolve(statements);
+    }
+    for (auto &subroutine : subroutines)
+    {
+        for (auto &statements : subroutine.lines)
+        {
+            resolve(statements);
+        }
+    }
 
-    // Open the preprocessed file
-    program.open(preprocessedFileName);
+    // Report a goto to a subroutine which is not defined before anything runs
+    // The lines of the subroutines are also lines of the program, so their calls are checked here too
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        checkCalls(lines[i], i + 1);
+    }
 
-    // If the file is not found
-    if (program.fail())
+    // Compile the program with its subroutines and run it on the virtual machine
+    if (engine == VM_ENGINE)
     {
-        cout << "File not found" << endl;
-        return 0;
+        Bytecode bytecode;
+        compile(lines, bytecode);
+        if (!cacheFile.empty())
+        {
+            saveCache(cacheFile, key, bytecode);
+        }
+        run(bytecode.code.data());
+        endProgram();
     }
 
     // Interpret the program line by line
-    string line;
-    while (getline(program, line))
+    for (auto &statements : lines)
     {
         currentLine++;
-        interpret(line);
+        interpret(statements);
     }
     endProgram();
     return 0;
@@ -63,1467 +195,5659 @@ int main(int argc, char *argv[])
 
 // Interpreter functions
 
-void interpret(string &expr)
+// Return how the statements end, escape and recheck skip the rest of them and are handed to the loop around
+int interpret(vector<Statement> &statements)
 {
     // expression1 and expression2 and ....
-    // set cursor at the beginning of the line
-    int cursor = 0;
-
-    // To remove the leading spaces
-    trim(expr, cursor);
-
-    // If the line is empty
-    if (expr[cursor] == '\0')
-    {
-        return;
-    }
-
-    // To read the first word of the line
-    string temp = "";
-    readUntilNextSpace(expr, cursor, temp);
-    trim(expr, cursor);
-
-    // To break the line into individual expressions
-    if (temp != keywordsToString.at(IF) && temp != keywordsToString.at(WHILE) && temp != keywordsToString.at(LEAVE))
+    for (auto &statement : statements)
     {
-        int j = cursor;
-        // If the next expression exists split the line and interpret them separately
-        if (nextExpressionExists(expr, j))
+        int flow = interpret(statement);
+        if (flow != NEXT_FLOW)
         {
-            string part1 = expr.substr(0, j);
-            string part2 = expr.substr(j + keywordsToString.at(AND).length());
-            interpret(part1);
-            interpret(part2);
-            return;
+            return flow;
         }
     }
-    if (temp == keywordsToString.at(LET))
-    {
-        initiate(expr);
-    }
-    else if (temp == keywordsToString.at(PRINT))
+    return NEXT_FLOW;
+}
+
+int interpret(Statement &statement)
+{
+    switch (statement.type)
     {
-        printOutput(expr, cursor);
-    }
-    else if (temp == keywordsToString.at(IF))
+    case ASSIGN_STATEMENT:
     {
-        // if condition then expression else expression stop
-        string condition = "";
-        int thenPosition = cursor;
-
-        // Find the position of THEN keyword
-        findKeyword(expr, thenPosition, THEN);
-
-        // The condition is between cursor and thenPosition
-        condition = expr.substr(cursor, thenPosition - cursor);
-
-        // Move the cursor to the position after THEN
-        cursor = thenPosition + keywordsToString.at(THEN).length();
-        trim(expr, cursor);
+        // Store the variable in custom Multitype class along with it's type
+        Multitype var = getVariable(statement.target);
 
-        // Find the position of ELSE keyword
-        int conjugateElsePosition = 0;
-        int ifCount = 1;
-        for (conjugateElsePosition = cursor; conjugateElsePosition < expr.length() - max(keywordsToString.at(ELSE).length(), keywordsToString.at(IF).length()) && ifCount != 0; conjugateElsePosition++)
+        // If the variable was not found
+        if (var.type == -1)
         {
-            if (expr.substr(conjugateElsePosition, keywordsToString.at(IF).length()) == keywordsToString.at(IF))
-            {
-                ifCount++;
-            }
-            else if (expr.substr(conjugateElsePosition, keywordsToString.at(ELSE).length()) == keywordsToString.at(ELSE))
-            {
-                ifCount--;
-            }
-            if (ifCount == 0)
-            {
-                break;
-            }
+            printError(VARIABLE_NOT_FOUND);
         }
-        int conjugateStopPosition = conjugateElsePosition + keywordsToString.at(ELSE).length();
-        int elseCount = 1;
-        for (conjugateStopPosition = conjugateElsePosition + keywordsToString.at(ELSE).length(); conjugateStopPosition < expr.length() - keywordsToString.at(STOP).length(); conjugateStopPosition++)
+
+        // If the IS keyword was missing
+        if (statement.error != -1)
         {
-            if (conjugateStopPosition < expr.length() - keywordsToString.at(ELSE).length() && expr.substr(conjugateStopPosition, keywordsToString.at(ELSE).length()) == keywordsToString.at(ELSE))
-            {
-                elseCount++;
-            }
-            else if (expr.substr(conjugateStopPosition, keywordsToString.at(STOP).length()) == keywordsToString.at(STOP))
-            {
-                elseCount--;
-            }
-            if (elseCount == 0)
-            {
-                break;
-            }
+            printError(statement.error);
         }
 
-        // Seperate the expressions for true and false conditions
-        string expressionWhenTrue, expressionWhenFalse;
-
-        // The part between then and else is the expression for true condition and between else and stop is for false condition
-        expressionWhenTrue = expr.substr(cursor, conjugateElsePosition - cursor);
-        expressionWhenFalse = expr.substr(conjugateElsePosition + keywordsToString.at(ELSE).length(), conjugateStopPosition - conjugateElsePosition - keywordsToString.at(ELSE).length());
-
-        if (checkCondition(condition))
+        // Solve the expression and store the value in the variable according to it's type
+        if (var.type == INTEGER)
         {
-            interpret(expressionWhenTrue);
+            *var.integer = solveForInteger(statement.postfix);
         }
-        else
+        else if (var.type == TEXT)
         {
-            interpret(expressionWhenFalse);
+            *var.text = solveForText(statement.postfix);
         }
-
-        // Move the cursor to the position after STOP
-        cursor = conjugateStopPosition + keywordsToString.at(STOP).length();
-        if (nextExpressionExists(expr, cursor))
+        else if (var.type == REAL)
         {
-            // Interpret the next expression
-            string nextExpression = expr.substr(cursor + keywordsToString.at(AND).length());
-            interpret(nextExpression);
-            return;
+            *var.real = solveForReal(statement.postfix);
         }
+        break;
     }
-    else if (temp == keywordsToString.at(WHILE))
-    {
-        // while condition do expression and expression till-here
-        string condition = "";
-
-        // Find the position of DO keyword
-        int doPosition = cursor;
-        findKeyword(expr, doPosition, DO);
-
-        // The condition is between cursor and doPosition
-        condition = expr.substr(cursor, doPosition - cursor);
-
-        // Move the cursor to the position after DO
-        cursor = doPosition + keywordsToString.at(DO).length();
-        trim(expr, cursor);
-
-        // Find the position of TILLHERE keyword
-        int tillherePosition = 0;
-        int whileCount = 1;
-        for (tillherePosition = cursor; tillherePosition < expr.length() - keywordsToString.at(TILLHERE).length(); tillherePosition++)
+    case LET_STATEMENT:
+        initiate(statement);
+        break;
+    case PRINT_STATEMENT:
+        printOutput(statement);
+        break;
+    case READ_STATEMENT:
+        readFromUser(statement);
+        break;
+    case IF_STATEMENT:
+        // if condition then expression else expression stop
+        if (checkCondition(statement.condition))
         {
-            if (tillherePosition < expr.length() - keywordsToString.at(WHILE).length() && expr.substr(tillherePosition, keywordsToString.at(WHILE).length()) == keywordsToString.at(WHILE))
-            {
-                whileCount++;
-            }
-            else if (expr.substr(tillherePosition, keywordsToString.at(TILLHERE).length()) == keywordsToString.at(TILLHERE))
-            {
-                whileCount--;
-            }
-            if (whileCount == 0)
-            {
-                break;
-            }
+            return interpret(statement.body);
         }
-
-        // The expression is between cursor and tillherePosition
-        string expression = expr.substr(cursor, tillherePosition - cursor);
-        while (checkCondition(condition))
+        return interpret(statement.otherwise);
+    case WHILE_STATEMENT:
+        // while condition do expression and expression till-here
+        // escape leaves the loop at once, recheck goes straight back to the condition
+        while (checkCondition(statement.condition))
         {
-            // If escape was triggered then break out of the loop
-            if (escape)
+            if (interpret(statement.body) == ESCAPE_FLOW)
             {
-                escape = 0;
                 break;
             }
-
-            // If recheck condition was triggered then continue the loop
-            if (recheckCondition)
-            {
-                recheckCondition = 0;
-                continue;
-            }
-
-            interpret(expression);
-        }
-
-        // Move the cursor to the position after TILLHERE
-        cursor = tillherePosition + keywordsToString.at(TILLHERE).length();
-        if (nextExpressionExists(expr, cursor))
-        {
-            // Interpret the next expression
-            string nextExpression = expr.substr(cursor + keywordsToString.at(AND).length());
-            interpret(nextExpression);
-            return;
         }
-    }
-    else if (temp == keywordsToString.at(GOTO))
+        break;
+    case GOTO_STATEMENT:
     {
         // goto subroutine-name
-
-        // Store the name of the subroutine
-        string subroutineName = "";
-        trim(expr, cursor);
-        readUntilNextSpace(expr, cursor, subroutineName);
+        // The subroutine was found when the program was loaded
 
         // Interpret the subroutine
-        for (auto &line : subroutines[subroutineName])
+        // Outside of a loop escape leaves the subroutine and recheck the rest of its line
+        for (auto &line : subroutines[identifierSubroutines[statement.target.id]].lines)
         {
-            // If escape was triggered then break out of the subroutine
-            if (escape)
+            if (interpret(line) == ESCAPE_FLOW)
             {
-                escape = 0;
-                return;
+                break;
             }
-            interpret(line);
         }
-        return;
-    }
-    else if (temp == keywordsToString.at(READ))
-    {
-        readFromUser(expr, cursor);
-    }
-    else if (temp == keywordsToString.at(LEAVE))
-    {
-        return;
-    }
-    else if (temp == keywordsToString.at(SKIP))
-    {
-        return;
+        break;
     }
-    else if (temp == keywordsToString.at(END))
-    {
+    case END_STATEMENT:
         endProgram();
+        break;
+    case ESCAPE_STATEMENT:
+        return ESCAPE_FLOW;
+    case RECHECK_STATEMENT:
+        return RECHECK_FLOW;
+    case SKIP_STATEMENT:
+        break;
+    default:
+        printError(statement.error);
     }
-    else if (temp == keywordsToString.at(ESCAPE))
-    {
-        escape = 1;
-        return;
-    }
-    else if (temp == keywordsToString.at(RECHECK))
-    {
-        recheckCondition = 1;
-        return;
-    }
-    else
-    {
-        // Store the variable in custom Multitype class along with it's type
-        Multitype var = getVariable(temp);
+    return NEXT_FLOW;
+}
 
-        // Type is not -1 means the variable is found
-        if (var.type != -1)
+// The expressions are solved with a loop over their postfix steps
+// Every operand is read before the first operator is applied, the order in which errors were always found
+int solveForInteger(Postfix &expr)
+{
+    int *stack = integerStack.data();
+    int top = 0;
+    for (auto &step : expr.steps)
+    {
+        if (step.type != OPERATOR_TOKEN)
         {
-            // Check if the next keyword is IS
-            trim(expr, cursor);
-            temp = "";
-            readUntilNextSpace(expr, cursor, temp);
-            if (temp != keywordsToString.at(IS))
-            {
-                printError(INVALID_SYNTAX);
-                
-            }
-
-            // Solve the expression and store the value in the variable according to it's type
-            if (var.type == INTEGER)
-            {
-                *var.integer = solveForInteger(expr, cursor);
-            }
-            else if (var.type == TEXT)
-            {
-                *var.text = solveForText(expr, cursor);
-            }
-            else if (var.type == REAL)
-            {
-                *var.real = solveForReal(expr, cursor);
-            }
+            stack[top++] = integerOperand(step);
+            continue;
         }
-        // If the variable was not found
-        else
+
+        // The right operand is on top, the result replaces the left one
+        int right = stack[--top];
+        int &result = stack[top - 1];
+        switch (step.id)
         {
-            printError(VARIABLE_NOT_FOUND);
-            
+        case PLUS:
+            result += right;
+            break;
+        case MINUS:
+            result -= right;
+            break;
+        case UPON:
+            result /= right;
+            break;
+        case INTO:
+            result *= right;
+            break;
+        case MODULO:
+            result %= right;
+            break;
+        case EXPONENT:
+            result = power(result, right);
+            break;
         }
     }
-}
-
-int solveForInteger(string &expr, int &position)
-{
-    trim(expr, position);
 
-    // If the expression is empty
-    if (expr[position] == '\0')
+    // If an operator was invalid
+    if (expr.error != -1)
     {
-        return 0;
+        printError(expr.error);
     }
 
-    int result = 0;
-
-    string temp = "";
-    readUntilNextSpace(expr, position, temp);
+    // If the expression is empty
+    return top == 0 ? 0 : stack[0];
+}
 
-    // If the next word is a number
-    if (isNumber(temp))
+string solveForText(Postfix &expr)
+{
+    // Texts can only be joined together, the operands before another operator are still read
+    if (expr.textOperands != -1)
     {
-        result = stoi(temp);
+        for (int i = 0; i < expr.textOperands; i++)
+        {
+            textOperand(expr.steps[i]);
+        }
+        printError(INVALID_SYNTAX);
     }
 
-    else
+    string *stack = textStack.data();
+    int top = 0;
+    for (auto &step : expr.steps)
     {
-        // If the variable is of number type then store the value in result
-        Multitype var = getVariable(temp);
-        if (var.type == INTEGER)
+        if (step.type != OPERATOR_TOKEN)
         {
-            result = *var.integer;
+            stack[top++] = textOperand(step);
+            continue;
         }
-        else if (var.type == REAL)
+        top--;
+        stack[top - 1] += stack[top];
+    }
+    return top == 0 ? "" : stack[0];
+}
+
+double solveForReal(Postfix &expr)
+{
+    double *stack = realStack.data();
+    int top = 0;
+    for (auto &step : expr.steps)
+    {
+        if (step.type != OPERATOR_TOKEN)
         {
-            result = *var.real;
+            stack[top++] = realOperand(step);
+            continue;
         }
-        // If the variable was not found
-        else
+
+        double right = stack[--top];
+        double &result = stack[top - 1];
+        switch (step.id)
         {
-            printError(VARIABLE_NOT_FOUND);
-            
+        case PLUS:
+            result += right;
+            break;
+        case MINUS:
+            result -= right;
+            break;
+        case UPON:
+            result /= right;
+            break;
+        case INTO:
+            result *= right;
+            break;
+        case MODULO:
+            result = fmod(result, right);
+            break;
+        case EXPONENT:
+            result = pow(result, right);
+            break;
         }
     }
+    if (expr.error != -1)
+    {
+        printError(expr.error);
+    }
+    return top == 0 ? 0.0 : stack[0];
+}
 
-    trim(expr, position);
-    if (expr[position] == '\0')
+// Read a single operand of an expression
+int integerOperand(Token &operand)
+{
+    // If the operand is a number
+    if (operand.type == NUMBER_TOKEN)
     {
-        return result;
+        // A literal which does not fit is converted again to fail the way it always did
+        Number &number = numbers[operand.id];
+        return number.integerValid ? number.integer : stoi(numberLiterals[operand.id]);
     }
 
-    // Read the operator
-    temp = "";
-    trim(expr, position);
-    readUntilNextSpace(expr, position, temp);
-    int op;
-    if (mathOperators.find(temp) != mathOperators.end())
+    // A missing last operand counts as zero
+    if (operand.type == -1)
     {
-        op = mathOperators.at(temp);
+        return 0;
     }
-    // If the operator was invalid
-    else
+    if (operand.type == REDUCTION_TOKEN)
     {
-        printError(INVALID_SYNTAX);
-        
+        Reduction &reduction = reductions[operand.id];
+        return integerReduction(reduction.kind, arrays[identifierArrays[reduction.identifier]]);
     }
 
-    switch (op)
+    // If the variable is of number type then return its value
+    Multitype var = getVariable(operand);
+    if (var.type == INTEGER)
     {
-    case PLUS:
-        result += solveForInteger(expr, position);
-        break;
-    case MINUS:
-        result -= solveForInteger(expr, position);
-        break;
-    case UPON:
-        result /= solveForInteger(expr, position);
-        break;
-    case INTO:
-        result *= solveForInteger(expr, position);
-        break;
-    case MODULO:
-        result %= solveForInteger(expr, position);
-        break;
-    case EXPONENT:
-        result = power(result, solveForInteger(expr, position));
-        break;
+        return *var.integer;
     }
-    return result;
+    if (var.type == REAL)
+    {
+        return *var.real;
+    }
+
+    // If the variable was not found
+    printError(VARIABLE_NOT_FOUND);
+    return 0;
 }
 
-string solveForText(string &expr, int &position)
+string &textOperand(Token &operand)
 {
+    static string empty = "";
 
-    // Return empty string if the expression is empty
-    trim(expr, position);
-    if (expr[position] == '\0')
+    // If the operand is a string literal
+    if (operand.type == STRING_TOKEN)
     {
-        return "";
+        return textLiterals[operand.id];
     }
-
-    string result = "";
-    string temp = "";
-    readUntilNextSpace(expr, position, temp);
-
-    // If the next word is a string literal
-    if (isString(temp))
+    if (operand.type == -1)
     {
-        result = temp.substr(1, temp.length() - 2);
+        return empty;
     }
-    else
+
+    // If the variable is of string type then return its value
+    Multitype var = getVariable(operand);
+    if (var.type != TEXT)
     {
-        // If the variable is of string type then store the value in result
-        Multitype var = getVariable(temp);
-        if (var.type == TEXT)
-        {
-            result = *var.text;
-        }
-        else
-        {
-            printError(VARIABLE_NOT_FOUND);
-            
-        }
-    }
-
-    trim(expr, position);
-    if (expr[position] == '\0')
-    {
-        return result;
-    }
-
-    string op = "";
-    readUntilNextSpace(expr, position, op);
-    if (mathOperators.at(op) == PLUS)
-    {
-        trim(expr, position);
-        result += solveForText(expr, position);
-    }
-    else
-    {
-        printError(INVALID_SYNTAX);
-        
+        printError(VARIABLE_NOT_FOUND);
     }
-    return result;
+    return *var.text;
 }
 
-double solveForReal(string &expr, int &position)
+double realOperand(Token &operand)
 {
-    trim(expr, position);
-    if (expr[position] == '\0')
-    {
-        return 0.0;
-    }
-
-    double result = 0.0;
-
-    string temp = "";
-    readUntilNextSpace(expr, position, temp);
-    if (isNumber(temp))
+    if (operand.type == NUMBER_TOKEN)
     {
-        result = stod(temp);
+        Number &number = numbers[operand.id];
+        return number.realValid ? number.real : stod(numberLiterals[operand.id]);
     }
-
-    else
+    if (operand.type == -1)
     {
-        Multitype var = getVariable(temp);
-        if (var.type == REAL)
-        {
-            result = *var.real;
-        }
-        else if (var.type == INTEGER)
-        {
-            result = *var.integer;
-        }
-        else
-        {
-            printError(VARIABLE_NOT_FOUND);
-            
-        }
+        return 0.0;
     }
-
-    trim(expr, position);
-    if (expr[position] == '\0')
+    if (operand.type == REDUCTION_TOKEN)
     {
-        return result;
+        Reduction &reduction = reductions[operand.id];
+        return realReduction(reduction.kind, arrays[identifierArrays[reduction.identifier]]);
     }
 
-    temp = "";
-    trim(expr, position);
-    readUntilNextSpace(expr, position, temp);
-    int op;
-    if (mathOperators.find(temp) != mathOperators.end())
-    {
-        op = mathOperators.at(temp);
-    }
-    else
+    Multitype var = getVariable(operand);
+    if (var.type == REAL)
     {
-        printError(INVALID_SYNTAX);
-        
+        return *var.real;
     }
-
-    switch (op)
+    if (var.type == INTEGER)
     {
-    case PLUS:
-        result += solveForReal(expr, position);
-        break;
-    case MINUS:
-        result -= solveForReal(expr, position);
-        break;
-    case UPON:
-        result /= solveForReal(expr, position);
-        break;
-    case INTO:
-        result *= solveForReal(expr, position);
-        break;
-    case MODULO:
-        result = fmod(result, solveForReal(expr, position));
-        break;
-    case EXPONENT:
-        result = pow(result, solveForReal(expr, position));
-        break;
+        return *var.integer;
     }
-    return result;
+    printError(VARIABLE_NOT_FOUND);
+    return 0.0;
 }
 
-int checkIntegralCondition(string &expr)
+int checkIntegralCondition(Condition &condition)
 {
     // leftHalf is logic rightHalf
-    int cursor = 0;
-    trim(expr, cursor);
-
-    // Seperate the conditional parts and the logical operator
-    string logic = "";
-    string leftHalf, rightHalf;
-
-    findKeyword(expr, cursor, IS);
-    leftHalf = expr.substr(0, cursor);
 
-    cursor += keywordsToString.at(IS).length();
-    trim(expr, cursor);
-
-    readUntilNextSpace(expr, cursor, logic);
-
-    trim(expr, cursor);
-    rightHalf = expr.substr(cursor);
-
-    // Dummy variables to pass as a parameter to solving functions
-    int dummy1 = 0, dummy2 = 0;
-
-    switch (logicalOperators.at(logic))
+    switch (condition.logic)
     {
     case LESS_THAN:
-        return (solveForInteger(leftHalf, dummy1) < solveForInteger(rightHalf, dummy2));
+        return (solveForInteger(condition.leftPostfix) < solveForInteger(condition.rightPostfix));
     case GREATER_THAN:
-        return (solveForInteger(leftHalf, dummy1) > solveForInteger(rightHalf, dummy2));
+        return (solveForInteger(condition.leftPostfix) > solveForInteger(condition.rightPostfix));
     case EQUAL_TO:
-        return (solveForInteger(leftHalf, dummy1) == solveForInteger(rightHalf, dummy2));
+        return (solveForInteger(condition.leftPostfix) == solveForInteger(condition.rightPostfix));
     case NOT_EQUAL_TO:
-        return (solveForInteger(leftHalf, dummy1) != solveForInteger(rightHalf, dummy2));
+        return (solveForInteger(condition.leftPostfix) != solveForInteger(condition.rightPostfix));
     default:
         printError(INVALID_OPERATOR);
         return 0;
     }
 }
 
-int checkTextCondition(string &expr)
+int checkTextCondition(Condition &condition)
 {
     // leftHalf is logic rightHalf
-    int cursor = 0;
-    trim(expr, cursor);
-
-    string logic = "";
-    string leftHalf, rightHalf;
-
-    findKeyword(expr, cursor, IS);
-    leftHalf = expr.substr(0, cursor);
-
-    cursor += keywordsToString.at(IS).length();
-    trim(expr, cursor);
 
-    readUntilNextSpace(expr, cursor, logic);
-
-    trim(expr, cursor);
-    rightHalf = expr.substr(cursor);
-
-    int dummy1 = 0, dummy2 = 0;
-
-    switch (logicalOperators.at(logic))
+    switch (condition.logic)
     {
     case LESS_THAN:
-        return (solveForText(leftHalf, dummy1) < solveForText(rightHalf, dummy2));
+        return (solveForText(condition.leftPostfix) < solveForText(condition.rightPostfix));
     case GREATER_THAN:
-        return (solveForText(leftHalf, dummy1) > solveForText(rightHalf, dummy2));
+        return (solveForText(condition.leftPostfix) > solveForText(condition.rightPostfix));
     case EQUAL_TO:
-        return (solveForText(leftHalf, dummy1).compare(solveForText(rightHalf, dummy2)) == 0);
+        return (solveForText(condition.leftPostfix).compare(solveForText(condition.rightPostfix)) == 0);
     case NOT_EQUAL_TO:
-        return (solveForText(leftHalf, dummy1).compare(solveForText(rightHalf, dummy2)) != 0);
+        return (solveForText(condition.leftPostfix).compare(solveForText(condition.rightPostfix)) != 0);
     default:
         printError(INVALID_OPERATOR);
         return 0;
     }
 }
 
-int checkRealCondition(string &expr)
+int checkRealCondition(Condition &condition)
 {
     // leftHalf is logic rightHalf
-    int cursor = 0;
-    trim(expr, cursor);
-
-    string logic = "";
-    string leftHalf, rightHalf;
-
-    findKeyword(expr, cursor, IS);
-    leftHalf = expr.substr(0, cursor);
-
-    cursor += keywordsToString.at(IS).length();
-    trim(expr, cursor);
-
-    readUntilNextSpace(expr, cursor, logic);
 
-    trim(expr, cursor);
-    rightHalf = expr.substr(cursor);
-
-    int dummy1 = 0, dummy2 = 0;
-
-    switch (logicalOperators.at(logic))
+    switch (condition.logic)
     {
     case LESS_THAN:
-        return (solveForReal(leftHalf, dummy1) < solveForReal(rightHalf, dummy2));
+        return (solveForReal(condition.leftPostfix) < solveForReal(condition.rightPostfix));
     case GREATER_THAN:
-        return (solveForReal(leftHalf, dummy1) > solveForReal(rightHalf, dummy2));
+        return (solveForReal(condition.leftPostfix) > solveForReal(condition.rightPostfix));
     case EQUAL_TO:
-        return (solveForReal(leftHalf, dummy1) == solveForReal(rightHalf, dummy2));
+        return (solveForReal(condition.leftPostfix) == solveForReal(condition.rightPostfix));
     case NOT_EQUAL_TO:
-        return (solveForReal(leftHalf, dummy1) != solveForReal(rightHalf, dummy2));
+        return (solveForReal(condition.leftPostfix) != solveForReal(condition.rightPostfix));
     default:
         printError(INVALID_OPERATOR);
         return 0;
     }
 }
 
-int checkCondition(string &expr)
+int checkCondition(Condition &condition)
 {
-    int cursor = 0;
-    trim(expr, cursor);
-    if (expr[cursor] == '\0')
+    // An empty condition is never true
+    if (condition.left.empty())
     {
+        if (condition.logic != -1)
+        {
+            printError(VARIABLE_NOT_FOUND);
+        }
         return 0;
     }
 
-    string temp = "";
-    readUntilNextSpace(expr, cursor, temp);
-
-    if (isString(temp))
+    // The first word of the condition decides how it is compared
+    Token &first = condition.left[0];
+    if (first.type == STRING_TOKEN)
+    {
+        return checkTextCondition(condition);
+    }
+    if (first.type == NUMBER_TOKEN)
     {
-        return checkTextCondition(expr);
+        if (numbers[first.id].isReal)
+        {
+            return checkRealCondition(condition);
+        }
+        return checkIntegralCondition(condition);
     }
-    if (isNumber(temp))
+
+    // A reduction is compared like a variable of the type it gives
+    if (first.type == REDUCTION_TOKEN)
     {
-        if (isReal(temp))
+        Reduction &reduction = reductions[first.id];
+        int type = reductionType(reduction.kind, arrays[identifierArrays[reduction.identifier]]);
+        if (type == INTEGER)
         {
-            return checkRealCondition(expr);
+            return checkIntegralCondition(condition);
         }
-        return checkIntegralCondition(expr);
+        if (type == REAL)
+        {
+            return checkRealCondition(condition);
+        }
+        // Texts are not summed or ordered
+        printError(type == TEXT ? INVALID_DATA_TYPE : VARIABLE_NOT_FOUND);
     }
 
-    Multitype var = getVariable(temp);
+    Multitype var = getVariable(first);
     if (var.type != -1)
     {
         if (var.type == INTEGER)
         {
-            return checkIntegralCondition(expr);
+            return checkIntegralCondition(condition);
         }
         else if (var.type == TEXT)
         {
-            return checkTextCondition(expr);
+            return checkTextCondition(condition);
         }
         else if (var.type == REAL)
         {
-            return checkRealCondition(expr);
+            return checkRealCondition(condition);
         }
     }
     else
     {
         printError(VARIABLE_NOT_FOUND);
-        
     }
     return 0;
 }
 
-void initiate(string &expr)
+void initiate(Statement &statement)
 {
     // let dataType name is value
     // let dataType name
     // let dataType-array name-size
 
-    int type = -1;
-    string name = "";
-    string temp = "";
-
-    int cursor = 0;
-
-    // To remove the extra "let" keyword from the beginning
-    trim(expr, cursor);
-    readUntilNextSpace(expr, cursor, temp);
-    trim(expr, cursor);
-
-    // Read the data type
-    temp = "";
-    readUntilNextSpace(expr, cursor, temp);
-    if (temp == dataTypeToString.at(INTEGER))
-    {
-        type = INTEGER;
-    }
-    else if (temp == dataTypeToString.at(TEXT))
-    {
-        type = TEXT;
-    }
-    else if (temp == dataTypeToString.at(REAL))
-    {
-        type = REAL;
-    }
-    else if (temp == dataTypeToString.at(INTEGER_ARRAY))
+    // Report the errors found while parsing
+    if (statement.error != -1)
     {
-        type = INTEGER_ARRAY;
-    }
-    else if (temp == dataTypeToString.at(TEXT_ARRAY))
-    {
-        type = TEXT_ARRAY;
-    }
-    else if (temp == dataTypeToString.at(REAL_ARRAY))
-    {
-        type = REAL_ARRAY;
-    }
-    else
-    {
-        printError(INVALID_DATA_TYPE);
-        
+        printError(statement.error);
     }
 
-    // Read the name of the variable
-    temp = "";
-    trim(expr, cursor);
-    readUntilNextSpace(expr, cursor, temp);
+    int type = statement.dataType;
 
     // If the variable is an array
-    int size = -1;
     if (type == INTEGER_ARRAY || type == TEXT_ARRAY || type == REAL_ARRAY)
     {
-        string arrayName;
-        for (int i = 0; i < temp.length(); i++)
+        // name-size was resolved like an element, the size is its index
+        int handle = -1, size = DEFAULT_ARRAY_SIZE;
+        int element = identifierElements[statement.target.id];
+        if (element != -1)
         {
-            // Seperate name and size the part before '-' is the name and after is the size
-            if (temp[i] == '-')
-            {
-                arrayName = temp.substr(0, i);
-                if (validateName(arrayName) == 0)
-                {
-                    printError(INVALID_NAME);
-                    
-                }
-
-                string indexString = temp.substr(temp.find('-') + 1);
-                int dummy = 0;
-                int index = solveForInteger(indexString, dummy);
-                size = index;
-                break;
-            }
-
-            // If the size is not provided then set the size to default
-            if (i == temp.length() - 1)
-            {
-                arrayName = temp;
-                size = DEFAULT_ARRAY_SIZE;
-            }
+            handle = elements[element].array;
+            size = elementIndex(elements[element]);
+        }
+        else
+        {
+            handle = arrayOf(statement.target.id);
         }
+
+        Array &array = arrays[handle];
         if (type == INTEGER_ARRAY)
         {
-            integerArrays[arrayName] = vector<int>(size, DEFAULT_INTEGER_VALUE);
+            array.integers.assign(size, DEFAULT_INTEGER_VALUE);
         }
         else if (type == TEXT_ARRAY)
         {
-            textArrays[arrayName] = vector<string>(size, DEFAULT_TEXT_VALUE);
+            array.texts.assign(size, DEFAULT_TEXT_VALUE);
         }
         else if (type == REAL_ARRAY)
         {
-            realArrays[arrayName] = vector<double>(size, DEFAULT_REAL_VALUE);
+            array.reals.assign(size, DEFAULT_REAL_VALUE);
         }
+        array.types |= 1 << type;
         return;
     }
 
-    name = temp;
-    if (validateName(name) == 0)
-    {
-        printError(INVALID_NAME);
-        
-    }
+    // A name with '-' in it can never be read back, its value is only solved
+    int slot = identifierSlots[statement.target.id];
+    Slot unnamed;
+    Slot &variable = slot == -1 ? unnamed : slots[slot];
 
     // If the value is not provided
-    temp = "";
-    trim(expr, cursor);
-    if (expr[cursor] == '\0')
+    if (statement.value.empty())
     {
         switch (type)
         {
         case INTEGER:
-            integerVariables[name] = DEFAULT_INTEGER_VALUE;
+            variable.integer = DEFAULT_INTEGER_VALUE;
             break;
         case TEXT:
-            textVariables[name] = DEFAULT_TEXT_VALUE;
+            variable.text = DEFAULT_TEXT_VALUE;
             break;
         case REAL:
-            realVariables[name] = DEFAULT_REAL_VALUE;
+            variable.real = DEFAULT_REAL_VALUE;
             break;
         }
+        variable.types |= 1 << type;
         return;
     }
 
-    // Read the IS keyword
-    readUntilNextSpace(expr, cursor, temp);
-    if (temp == keywordsToString.at(IS))
-    {
-        cursor++;
-        temp = "";
-        trim(expr, cursor);
-    }
-    else
-    {
-        printError(INVALID_SYNTAX);
-        
-    }
-
-    // Initiate the variable with the value
+    // Initiate the variable with the value, it gets its type once the value is solved
     if (type == INTEGER)
     {
-        integerVariables[name] = solveForInteger(expr, cursor);
+        variable.integer = solveForInteger(statement.postfix);
     }
     else if (type == TEXT)
     {
-        textVariables[name] = solveForText(expr, cursor);
+        variable.text = solveForText(statement.postfix);
     }
     else if (type == REAL)
     {
-        realVariables[name] = solveForReal(expr, cursor);
+        variable.real = solveForReal(statement.postfix);
     }
+    variable.types |= 1 << type;
 }
 
-void printOutput(string &expr, int &position)
+void printOutput(Statement &statement)
 {
     // print "a: " then a
-
-    trim(expr, position);
-    if (expr[position] == '\0')
+    for (auto &value : statement.items)
     {
-        return;
-    }
+        // If the value to be printed is a string literal print is without quotes
+        if (value.type == STRING_TOKEN)
+        {
+            outputText(textLiterals[value.id]);
+            continue;
+        }
 
-    string temp = "";
-    readUntilNextSpace(expr, position, temp);
+        if (value.type == REDUCTION_TOKEN)
+        {
+            Reduction &reduction = reductions[value.id];
+            printReduction(reduction.kind, arrays[identifierArrays[reduction.identifier]]);
+            continue;
+        }
 
-    // If the value to be printed is a string literal print is without quotes
-    if (isString(temp))
-    {
-        cout << temp.substr(1, temp.length() - 2);
-    }
+        // If the value to be printed is variable
+        Multitype var = getVariable(value);
 
-    // If the value to be printed is variable
-    else
-    {
-        readUntilNextSpace(expr, position, temp);
-        Multitype var = getVariable(temp);
+        // The name of an array without an index prints the whole array, unless it is also a variable
+        if (var.type == -1 && value.type == IDENTIFIER_TOKEN && identifierArrays[value.id] != -1 && printArray(arrays[identifierArrays[value.id]]))
+        {
+            continue;
+        }
         if (var.type != -1)
         {
             if (var.type == INTEGER)
             {
-                cout << *var.integer;
+                outputInteger(*var.integer);
             }
             else if (var.type == TEXT)
             {
-                cout << *var.text;
+                outputText(*var.text);
             }
             else if (var.type == REAL)
             {
-                cout << *var.real;
+                outputReal(*var.real);
             }
         }
         else
         {
             printError(VARIABLE_NOT_FOUND);
-            
         }
     }
 
-    temp = "";
-    trim(expr, position);
-    if (expr[position] == '\0')
-    {
-        return;
-    }
-
-    // Check if the printing is chained
-    readUntilNextSpace(expr, position, temp);
-    if (temp == keywordsToString.at(THEN))
-    {
-        printOutput(expr, position);
-    }
-
-    else
+    // If the printing was not chained properly
+    if (statement.error != -1)
     {
-        printError(INVALID_SYNTAX);
-        
+        printError(statement.error);
     }
 }
 
 void endProgram()
 {
-    program.close();
-    remove(preprocessedFileName.c_str());
+    flushOutput();
     exit(0);
 }
 
-void readFromUser(string &expr, int &position)
+void readFromUser(Statement &statement)
 {
-    trim(expr, position);
-    if (expr[position] == '\0')
+    flushForInput();
+    for (auto &value : statement.items)
     {
-        return;
-    }
+        // Get the address of variable in Multitype and read the value from user
+        Multitype var = getVariable(value);
 
-    // Get the variable name
-    string temp = "";
-    readUntilNextSpace(expr, position, temp);
-
-    // Get the address of variable in Multitype and read the value from user
-    Multitype var = getVariable(temp);
-    if (var.type != -1)
-    {
-        if (var.type == INTEGER)
+        // The name of an array without an index reads the whole array, unless it is also a variable
+        if (var.type == -1 && value.type == IDENTIFIER_TOKEN && identifierArrays[value.id] != -1 && readArray(arrays[identifierArrays[value.id]]))
         {
-            cin >> *var.integer;
+            continue;
         }
-        else if (var.type == TEXT)
+        if (var.type != -1)
         {
-            cin >> *var.text;
+            if (var.type == INTEGER)
+            {
+                inputInteger(*var.integer);
+            }
+            else if (var.type == TEXT)
+            {
+                inputText(*var.text);
+            }
+            else if (var.type == REAL)
+            {
+                inputReal(*var.real);
+            }
         }
-        else if (var.type == REAL)
+        else
         {
-            cin >> *var.real;
+            printError(VARIABLE_NOT_FOUND);
         }
     }
-    else
-    {
-        printError(VARIABLE_NOT_FOUND);
-        
-    }
-
-    trim(expr, position);
-    if (expr[position] == '\0')
-    {
-        return;
-    }
 
-    // Check if the reading is chained
-    temp = "";
-    readUntilNextSpace(expr, position, temp);
-    if (temp == keywordsToString.at(THEN))
-    {
-        readFromUser(expr, position);
-    }
-    else
+    // If the reading was not chained properly
+    if (statement.error != -1)
     {
-        printError(INVALID_SYNTAX);
-        
+        printError(statement.error);
     }
 }
 
 void printError(int errCode)
 {
-    cout << "Error at line : " << currentLine << endl;
-    cout << errorMassage.at(errCode) << endl;
+    outputText("Error at line : ");
+    outputInteger(currentLine);
+    outputText("\n" + errorMassage.at(errCode) + "\n");
     endProgram();
 }
 
-// Utility Functions
+// Output functions
 
-int power(int number, int exponent)
+// The output is collected in outputBuffer and written with a single write whenever the buffer fills up
+void outputBytes(const char *bytes, size_t size)
 {
-    int result = 1;
-    for (int i = 0; i < exponent; i++)
+    if (outputSize + size > OUTPUT_BUFFER_SIZE)
     {
-        result *= number;
+        flushOutput();
+
+        // Bytes which do not fit in the buffer at all are written straight away
+        if (size > OUTPUT_BUFFER_SIZE)
+        {
+            writeOutput(bytes, size);
+            return;
+        }
     }
-    return result;
+    memcpy(outputBuffer + outputSize, bytes, size);
+    outputSize += size;
 }
 
-// Move the cursor to the first character
-void trim(string &str, int &position)
+void outputText(const string &text)
 {
-    while (str[position] == ' ' && str[position] != '\0')
-    {
-        position++;
-    }
+    outputBytes(text.data(), text.size());
 }
 
-// Read the expression until the next space
-void readUntilNextSpace(string &expr, int &position, string &temp)
+void outputInteger(int value)
 {
-    char checkFor = ' ';
-    if (expr[position] == '"')
-    {
-        checkFor = '"';
-        temp += expr[position];
-        position++;
-    }
-    while (expr[position] != checkFor && expr[position] != '\0')
-    {
-        temp += expr[position];
-        position++;
-    }
-    if (checkFor == '"' && expr[position] != '\0')
-    {
-        temp += expr[position];
-        position++;
-    }
+    char digits[16];
+    char *end = to_chars(digits, digits + sizeof(digits), value).ptr;
+    outputBytes(digits, end - digits);
+}
+
+// Reals are written like cout writes them, with 6 significant digits
+void outputReal(double value)
+{
+    char digits[32];
+    char *end = to_chars(digits, digits + sizeof(digits), value, chars_format::general, 6).ptr;
+    outputBytes(digits, end - digits);
 }
 
-// Check if the next expression exists (AND keyword)
-int nextExpressionExists(string &expr, int &position)
+void flushOutput()
 {
-    return findKeyword(expr, position, AND);
+    writeOutput(outputBuffer, outputSize);
+    outputSize = 0;
 }
 
-// Find a specific keyword in the expression and move the cursor to the first character of the keyword
-int findKeyword(string &expr, int &position, int keyword)
+// Print every element of the array with the separator between them, false if the array is not declared
+// The arrays of a name are tried in the order integer, real, text like getElement does
+int printArray(Array &array)
 {
-    while (position < expr.length() - keywordsToString.at(keyword).length())
+    if (array.types & (1 << INTEGER_ARRAY))
     {
-        if (expr[position] == '"')
+        for (size_t i = 0; i < array.integers.size(); i++)
         {
-            position++;
-            while (expr[position] != '"' && position < expr.length())
+            if (i > 0)
             {
-                position++;
+                outputText(ARRAY_SEPARATOR);
             }
-            position++;
-        }
-        if (expr.substr(position, keywordsToString.at(keyword).length()) == keywordsToString.at(keyword))
-        {
-            if ((position == 0 || expr[position - 1] == ' ') && (expr[position + keywordsToString.at(keyword).length()] == ' ' || expr[position + keywordsToString.at(keyword).length()] == '\0'))
-                return true;
+            outputInteger(array.integers[i]);
         }
-        position++;
     }
-    return false;
-}
-
-// Check if the string is a number
-int isNumber(string &str)
-{
-    int dotCount = 0;
-    for (int i = 0; i < str.length(); i++)
+    else if (array.types & (1 << REAL_ARRAY))
     {
-        if (str[i] < '0' || str[i] > '9')
+        for (size_t i = 0; i < array.reals.size(); i++)
         {
-            if (str[i] == '-' && i == 0)
+            if (i > 0)
             {
-                continue;
+                outputText(ARRAY_SEPARATOR);
             }
-            if (str[i] == '.' && dotCount == 0)
+            outputReal(array.reals[i]);
+        }
+    }
+    else if (array.types & (1 << TEXT_ARRAY))
+    {
+        for (size_t i = 0; i < array.texts.size(); i++)
+        {
+            if (i > 0)
             {
-                dotCount++;
-                continue;
+                outputText(ARRAY_SEPARATOR);
             }
-            return false;
+            outputText(array.texts[i]);
         }
     }
+    else
+    {
+        return false;
+    }
     return true;
 }
 
-// Check if the string is a string literal (Enclosed in double quotes)
-int isString(string &str)
+// Show the output before the program waits for input typed on a terminal
+void flushForInput()
 {
-    if (str[0] == '"' && str[str.length() - 1] == '"')
+    if (interactiveInput)
     {
-        return true;
+        flushOutput();
     }
-    return false;
 }
 
-// Check if the string is a real number
-int isReal(string &str)
+// Write the bytes to the standard output, a single write can take only part of them
+void writeOutput(const char *bytes, size_t size)
 {
-    int dotCount = 0;
-    for (int i = 0; i < str.length(); i++)
+#ifdef SYMLS_POSIX_IO
+    int descriptor = fileno(stdout);
+    while (size > 0)
     {
-        if (str[i] < '0' || str[i] > '9')
+        ssize_t written = write(descriptor, bytes, size);
+        if (written < 0)
         {
-            if (str[i] == '-' && i == 0)
-            {
-                continue;
-            }
-            if (str[i] == '.' && dotCount == 0)
+            if (errno == EINTR)
             {
-                dotCount++;
                 continue;
             }
-            return false;
+            return;
         }
+        bytes += written;
+        size -= written;
     }
-    if (dotCount == 1)
+#else
+    fwrite(bytes, 1, size, stdout);
+    fflush(stdout);
+#endif
+}
+
+// Input functions
+
+// The input is read into inputBuffer in large blocks and parsed from there
+// Values are separated by white space and a value which can not be read stops all later reads, like cin does
+int peekInput()
+{
+    if (inputStart == inputEnd && !refillInput())
     {
-        return true;
+        return -1;
     }
-    return false;
+    return (unsigned char)inputBuffer[inputStart];
 }
 
-// Validate the name of the variable
-int validateName(string name)
+int refillInput()
 {
-    // Name cannot be empty
-    if (name[0] == '\n')
+    if (inputEnded)
+    {
         return false;
-
-    // Name cannot start with a number
-    if (name[0] >= '0' && name[0] <= '0')
+    }
+#ifdef SYMLS_POSIX_IO
+    ssize_t size;
+    do
+    {
+        size = read(fileno(stdin), inputBuffer, INPUT_BUFFER_SIZE);
+    } while (size < 0 && errno == EINTR);
+#else
+    long long size = fread(inputBuffer, 1, INPUT_BUFFER_SIZE, stdin);
+#endif
+    if (size <= 0)
+    {
+        inputEnded = true;
         return false;
+    }
+    inputStart = 0;
+    inputEnd = size;
+    return true;
+}
 
-    // Name can only contain alphabets and numbers
-    for (int i = 0; i < name.length(); i++)
+// Skip the white space before a value, false if there is no value left to read
+int skipSpaces()
+{
+    if (inputFailed)
     {
-        if (name[i] >= '0' && name[i] <= '9')
-            continue;
-        if (name[i] >= 'a' && name[i] <= 'z')
-            continue;
-        if (name[i] >= 'A' && name[i] <= 'Z')
-            continue;
         return false;
     }
-
-    // Name cannot be a reserved keyword
-    for (auto reserved : reservedWords)
+    int byte = peekInput();
+    while (byte == ' ' || (byte >= '\t' && byte <= '\r'))
     {
-        if (name.compare(reserved) == 0)
-            return false;
+        inputStart++;
+        byte = peekInput();
+    }
+    if (byte == -1)
+    {
+        inputFailed = true;
+        return false;
     }
     return true;
 }
 
-Multitype getVariable(string varName)
+// An integer which does not fit is read as the largest or smallest integer and stops the reads
+int inputInteger(int &value)
 {
-    // If the variable is an array
-    Multitype variable;
-    if (varName.find('-') != string::npos)
+    if (!skipSpaces())
     {
-        // Seperate the name and index
-        string arrayName = varName.substr(0, varName.find('-'));
-        string indexString = varName.substr(varName.find('-') + 1);
-
-        int dummy = 0;
-        int index = solveForInteger(indexString, dummy);
+        return false;
+    }
+    int byte = peekInput(), negative = false;
+    if (byte == '-' || byte == '+')
+    {
+        negative = byte == '-';
+        inputStart++;
+        byte = peekInput();
+    }
+    if (byte < '0' || byte > '9')
+    {
+        value = 0;
+        inputFailed = true;
+        return false;
+    }
+    long long number = 0;
+    while (byte >= '0' && byte <= '9')
+    {
+        if (number <= (long long)INT_MAX + 1)
+        {
+            number = number * 10 + (byte - '0');
+        }
+        inputStart++;
+        byte = peekInput();
+    }
+    if (number > (long long)INT_MAX + negative)
+    {
+        value = negative ? INT_MIN : INT_MAX;
+        inputFailed = true;
+        return false;
+    }
+    value = negative ? -number : number;
+    return true;
+}
 
-        // Check the type of the array and store the address of the variable
-        if (integerArrays.find(arrayName) != integerArrays.end())
+// The digits are gathered like cin gathers them, a sign, digits with a point and an exponent
+// Up to 19 digits with a small exponent are converted exactly with one multiplication or division,
+// the others are left to strtod
+int inputReal(double &value)
+{
+    if (!skipSpaces())
+    {
+        return false;
+    }
+    inputToken.clear();
+    unsigned long long mantissa = 0;
+    int digits = 0, mantissaDigits = 0, fraction = 0, point = false, exponent = false, exponentDigits = 0, power = 0, negativePower = false;
+    int byte = peekInput();
+    if (byte == '-' || byte == '+')
+    {
+        inputToken.push_back(byte);
+        inputStart++;
+        byte = peekInput();
+    }
+    while (byte != -1)
+    {
+        if (byte >= '0' && byte <= '9')
         {
-            if (index >= 0 && index < integerArrays[arrayName].size())
+            if (exponent)
             {
-                variable.integer = &integerArrays[arrayName][index];
-                variable.type = INTEGER;
+                power = power < 100000 ? power * 10 + (byte - '0') : power;
+                exponentDigits++;
             }
-
-            // If the index is out of bounds
             else
             {
-                printError(INDEX_OUT_OF_BOUNDS);
-                
+                digits++;
+                if (mantissa != 0 || byte != '0')
+                {
+                    mantissa = mantissaDigits < 19 ? mantissa * 10 + (byte - '0') : mantissa;
+                    mantissaDigits++;
+                }
+                fraction += point;
             }
         }
-        else if (realArrays.find(arrayName) != realArrays.end())
+        else if (byte == '.' && !point && !exponent)
         {
-            if (index >= 0 && index < realArrays[arrayName].size())
-            {
-                variable.real = &realArrays[arrayName][index];
-                variable.type = REAL;
-            }
-            else
-            {
-                printError(INDEX_OUT_OF_BOUNDS);
-                
-            }
+            point = true;
         }
-        else if (textArrays.find(arrayName) != textArrays.end())
+        else if ((byte == 'e' || byte == 'E') && digits > 0 && !exponent)
         {
-            if (index >= 0 && index < textArrays[arrayName].size())
+            exponent = true;
+            inputToken.push_back(byte);
+            inputStart++;
+            byte = peekInput();
+            if (byte == '-' || byte == '+')
             {
-                variable.text = &textArrays[arrayName][index];
-                variable.type = TEXT;
+                negativePower = byte == '-';
             }
             else
             {
-                printError(INDEX_OUT_OF_BOUNDS);
-                
+                continue;
             }
         }
+        else
+        {
+            break;
+        }
+        inputToken.push_back(byte);
+        inputStart++;
+        byte = peekInput();
     }
-    else if (integerVariables.find(varName) != integerVariables.end())
+    if (digits == 0 || (exponent && exponentDigits == 0))
     {
-        variable.integer = &integerVariables[varName];
-        variable.type = INTEGER;
+        value = 0.0;
+        inputFailed = true;
+        return false;
     }
-    else if (textVariables.find(varName) != textVariables.end())
+
+    int scale = (negativePower ? -power : power) - fraction;
+    if (mantissaDigits <= 19 && mantissa <= (1ull << 53) && scale >= -22 && scale <= 22)
     {
-        variable.text = &textVariables[varName];
-        variable.type = TEXT;
+        value = scale < 0 ? mantissa / POWERS_OF_TEN[-scale] : mantissa * POWERS_OF_TEN[scale];
     }
-    else if (realVariables.find(varName) != realVariables.end())
+    else
     {
-        variable.real = &realVariables[varName];
-        variable.type = REAL;
+        value = fabs(strtod(inputToken.c_str(), nullptr));
+        if (value == HUGE_VAL)
+        {
+            value = inputToken[0] == '-' ? -DBL_MAX : DBL_MAX;
+            inputFailed = true;
+            return false;
+        }
     }
-    else
+    if (inputToken[0] == '-')
     {
-        variable.type = -1;
+        value = -value;
     }
-    return variable;
+    return true;
 }
 
-// Preprocessor functions
-
-void preprocess(string fileName)
+int inputText(string &text)
 {
-    // Open the file in which the preprocessed code will be stored
-    ofstream processedProgram(preprocessedFileName);
-
-    // If the file is opened successfully
-    if (processedProgram.is_open())
+    if (!skipSpaces())
     {
-        // Open the program file
-        ifstream program(fileName);
-
-        string line, modifiedLine = "";
-
-        // Read the file line by line
-        while (getline(program, line))
+        return false;
+    }
+    text.clear();
+    int byte = peekInput();
+    while (byte != -1 && byte != ' ' && (byte < '\t' || byte > '\r'))
+    {
+        // Take the whole run of bytes in the buffer at once
+        size_t end = inputStart;
+        while (end < inputEnd && inputBuffer[end] != ' ' && (inputBuffer[end] < '\t' || inputBuffer[end] > '\r'))
         {
-            modifiedLine = "";
-            int cursor = 0;
-            trim(line, cursor);
+            end++;
+        }
+        text.append(inputBuffer + inputStart, end - inputStart);
+        inputStart = end;
+        byte = peekInput();
+    }
+    return true;
+}
 
-            // skip the line if it is empty
-            if (line[cursor] == '\0')
+// Fill every element of the array with the values read one after the other, false if the array is not declared
+// The arrays of a name are tried in the order integer, real, text like getElement does
+int readArray(Array &array)
+{
+    if (array.types & (1 << INTEGER_ARRAY))
+    {
+        for (auto &value : array.integers)
+        {
+            if (!inputInteger(value))
             {
-                continue;
+                break;
             }
-
-            // Skip comments
-            if (line.length() >= keywordsToString.at(LEAVE).length() && line.substr(cursor, keywordsToString.at(LEAVE).length()) == keywordsToString.at(LEAVE))
+        }
+    }
+    else if (array.types & (1 << REAL_ARRAY))
+    {
+        for (auto &value : array.reals)
+        {
+            if (!inputReal(value))
             {
-                continue;
+                break;
             }
-
-            // Read the line character by character
-            while (cursor < line.length())
+        }
+    }
+    else if (array.types & (1 << TEXT_ARRAY))
+    {
+        for (auto &value : array.texts)
+        {
+            if (!inputText(value))
             {
-                // Ignore string literalts (part inside double quotes)
-                if (line[cursor] == '"')
-                {
-                    modifiedLine.push_back(line[cursor]);
-                    cursor++;
-
-                    while (line[cursor] != '"' && cursor < line.length())
-                    {
-                        modifiedLine.push_back(line[cursor]);
-                        cursor++;
-                    }
-
-                    if (cursor == line.length())
-                    {
-                        break;
-                    }
-
-                    else
-                    {
-                        modifiedLine.push_back(line[cursor]);
-                        cursor++;
-                    }
-                }
+                break;
+            }
+        }
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
 
-                // Append the character to the modified line if it is not a space
-                else if (line[cursor] != ' ')
-                {
-                    modifiedLine.push_back(line[cursor]);
-                    cursor++;
-                }
+// A line of the program typed in the line mode, without its newline
+int inputLine(string &line)
+{
+    if (inputFailed)
+    {
+        return false;
+    }
+    if (peekInput() == -1)
+    {
+        inputFailed = true;
+        return false;
+    }
+    line.clear();
+    while (peekInput() != -1)
+    {
+        char *newline = (char *)memchr(inputBuffer + inputStart, '\n', inputEnd - inputStart);
+        if (newline != nullptr)
+        {
+            line.append(inputBuffer + inputStart, newline - (inputBuffer + inputStart));
+            inputStart = newline - inputBuffer + 1;
+            break;
+        }
+        line.append(inputBuffer + inputStart, inputEnd - inputStart);
+        inputStart = inputEnd;
+    }
+    return true;
+}
 
-                // Append only one space if there are multiple spaces continuously
-                else if (modifiedLine.length() > 0 && modifiedLine[modifiedLine.length() - 1] != ' ')
-                {
-                    modifiedLine.push_back(' ');
-                    cursor++;
-                }
-                else
-                    cursor++;
-            }
-            // Remove the last space if it exists
-            if (modifiedLine.back() == ' ')
-            {
-                modifiedLine.pop_back();
-            }
+// Tokenizer functions
+
+// Break a preprocessed line into tokens
+void tokenize(string &line, vector<Token> &tokens)
+{
+    int cursor = 0;
+    trim(line, cursor);
+    while (line[cursor] != '\0')
+    {
+        string word = "";
+        readUntilNextSpace(line, cursor, word);
+        tokens.push_back(classifyWord(word));
+        trim(line, cursor);
+    }
+}
 
-            processedProgram << modifiedLine;
+// Find out what a single word of the program is
+Token classifyWord(string &word)
+{
+    Token token;
 
-            // Read the last word of the line
-            string lastWord = "";
-            if (!modifiedLine.empty())
-            {
-                size_t lastSpace = modifiedLine.find_last_of(' ');
-                if (lastSpace != string::npos)
-                {
-                    lastWord = modifiedLine.substr(lastSpace + 1);
-                }
+    // Keywords, operators and data types
+    if (recognizeWord(word.data(), word.size(), token))
+    {
+        return token;
+    }
 
-                // If there is only one word in the line
-                else
-                {
-                    lastWord = modifiedLine;
-                }
-            }
+    // Store string literals without the quotes
+    if (isString(word))
+    {
+        token.type = STRING_TOKEN;
+        token.id = textLiterals.size();
+        textLiterals.push_back(word.substr(1, word.length() - 2));
+    }
+    else if (isNumber(word))
+    {
+        token.type = NUMBER_TOKEN;
+        token.id = internNumber(word);
+    }
+    else
+    {
+        token.type = IDENTIFIER_TOKEN;
+        token.id = internIdentifier(word);
+    }
+    return token;
+}
 
-            // If the last word is not AND, THEN, ELSE, DO then chain the next line with the current line
-            if (lastWord.compare(keywordsToString.at(AND)) != 0 && lastWord.compare(keywordsToString.at(THEN)) != 0 && lastWord.compare(keywordsToString.at(ELSE)) != 0 && lastWord.compare(keywordsToString.at(DO)) != 0)
-            {
-                processedProgram << endl;
-            }
+// Find the keyword, operator or data type spelled by the bytes, false if they are none of them
+int recognizeWord(const char *bytes, size_t length, Token &token)
+{
+    if (!recognizerBuilt)
+    {
+        buildRecognizer();
+    }
+    ReservedWord &entry = recognizer[hashWord(bytes, length, recognizerSeed)];
+    if (entry.word == nullptr || entry.word->size() != length || memcmp(entry.word->data(), bytes, length) != 0)
+    {
+        return false;
+    }
+    token.type = entry.type;
+    token.id = entry.id;
+    return true;
+}
 
-            else
-                processedProgram << " ";
+// Build the perfect hash from the spellings of the active configuration
+void buildRecognizer()
+{
+    // newline is a predefined text variable and not a statement
+    // A word configured more than once keeps the meaning it is found with first
+    ReservedWord words[RECOGNIZER_SIZE];
+    int count = 0;
+    for (auto &pair : keywords)
+    {
+        if (pair.second != NEWLINE)
+        {
+            addReservedWord(words, count, pair.first, KEYWORD_TOKEN, pair.second);
+        }
+    }
+    for (auto &pair : mathOperators)
+    {
+        addReservedWord(words, count, pair.first, OPERATOR_TOKEN, pair.second);
+    }
+    for (auto &pair : logicalOperators)
+    {
+        addReservedWord(words, count, pair.first, OPERATOR_TOKEN, pair.second);
+    }
+    for (auto &pair : dataTypes)
+    {
+        addReservedWord(words, count, pair.first, DATA_TYPE_TOKEN, pair.second);
+    }
+
+    // The table has several times more entries than there are words, so a seed without collisions is found quickly
+    for (recognizerSeed = 1;; recognizerSeed++)
+    {
+        for (auto &entry : recognizer)
+        {
+            entry.word = nullptr;
+        }
+        int collided = false;
+        for (int i = 0; i < count && !collided; i++)
+        {
+            ReservedWord &entry = recognizer[hashWord(words[i].word->data(), words[i].word->size(), recognizerSeed)];
+            collided = entry.word != nullptr;
+            entry = words[i];
         }
-        program.close();
-        processedProgram.close();
+        if (!collided)
+        {
+            break;
+        }
+    }
+    recognizerBuilt = true;
+}
 
-        // Open the preprocessed file to preload the subroutines
-        program.open(preprocessedFileName);
-        while (getline(program, line))
+void addReservedWord(ReservedWord words[], int &count, const string &word, int type, int id)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (words[i].word->compare(word) == 0)
         {
-            string temp = "";
-            int cursor = 0;
+            return;
+        }
+    }
+    if (count < RECOGNIZER_SIZE / 2)
+    {
+        words[count++] = {&word, type, id};
+    }
+}
 
-            // Filter the lines which start with the keyword SUBROUTINE
-            trim(line, cursor);
-            readUntilNextSpace(line, cursor, temp);
-            if (temp.compare(keywordsToString.at(SUBROUTINE)) == 0)
-            {
-                string subroutineName = "";
-                trim(line, cursor);
+// FNV-1a started from the seed, reduced to an entry of the recognizer
+unsigned int hashWord(const char *bytes, size_t length, unsigned int seed)
+{
+    unsigned int hash = 2166136261u ^ (seed * 2654435761u);
+    for (size_t i = 0; i < length; i++)
+    {
+        hash = (hash ^ (unsigned char)bytes[i]) * 16777619u;
+    }
+    hash ^= hash >> 15;
+    return hash & (RECOGNIZER_SIZE - 1);
+}
 
-                // Read the name of the subroutine
-                readUntilNextSpace(line, cursor, subroutineName);
+// Give every distinct name a small number so that tokens do not have to carry strings
+int internIdentifier(string &name)
+{
+    int id = findIdentifier(name);
+    if (id != -1)
+    {
+        return id;
+    }
 
-                // Store the code of the subroutine
-                vector<string> subroutineCode;
-                while (getline(program, line))
-                {
-                    if (line == keywordsToString.at(END))
-                    {
-                        break;
-                    }
-                    subroutineCode.push_back(line);
-                }
-                subroutines[subroutineName] = subroutineCode;
+    // Keep at least half of the buckets empty so that probes stay short
+    if (2 * (identifierNames.size() + 1) > symbolTable.size())
+    {
+        vector<SymbolBucket> buckets(symbolTable.empty() ? 64 : 2 * symbolTable.size(), {0, -1});
+        for (auto &bucket : symbolTable)
+        {
+            if (bucket.identifier == -1)
+                continue;
+            int position = bucket.hash & (buckets.size() - 1);
+            while (buckets[position].identifier != -1)
+            {
+                position = (position + 1) & (buckets.size() - 1);
             }
+            buckets[position] = bucket;
         }
+        symbolTable.swap(buckets);
+    }
+
+    unsigned int hash = hashName(name);
+    int position = hash & (symbolTable.size() - 1);
+    while (symbolTable[position].identifier != -1)
+    {
+        position = (position + 1) & (symbolTable.size() - 1);
     }
+    id = identifierNames.size();
+    symbolTable[position] = {hash, id};
+    identifierNames.push_back(name);
+    identifierSlots.push_back(-1);
+    identifierArrays.push_back(-1);
+    identifierElements.push_back(-1);
+    identifierSubroutines.push_back(-1);
+    identifierBases.push_back(-1);
+    identifierTypes.push_back(0);
+    return id;
 }
 
-void configure()
+// The identifier of a name, -1 if it was never interned
+int findIdentifier(string &name)
 {
-    using json = nlohmann::json;
+    if (symbolTable.empty())
+    {
+        return -1;
+    }
+    unsigned int hash = hashName(name);
+    int position = hash & (symbolTable.size() - 1);
+    while (symbolTable[position].identifier != -1)
+    {
+        SymbolBucket &bucket = symbolTable[position];
+        if (bucket.hash == hash && identifierNames[bucket.identifier] == name)
+        {
+            return bucket.identifier;
+        }
+        position = (position + 1) & (symbolTable.size() - 1);
+    }
+    return -1;
+}
 
-    // Open the configuration file
-    ifstream configFile(configFileName);
-    if (configFile.fail())
+// FNV-1a hash of a name
+unsigned int hashName(string &name)
+{
+    unsigned int hash = 2166136261u;
+    for (char c : name)
     {
-        return;
+        hash = (hash ^ (unsigned char)c) * 16777619u;
     }
+    return hash;
+}
 
-    // Store the data of the configuration file in a string
-    string configurations((istreambuf_iterator<char>(configFile)), istreambuf_iterator<char>());
-    configFile.close();
-
-    // Parse the configuration file using nolhmann json library
-    json config = json::parse(configurations);
-
-    // Cofigure I/O files
-    string inputFile = config["io"]["inputFile"];
-    string outputFile = config["io"]["outputFile"];
-    string errorFile = config["io"]["errorFile"];
-    preprocessedFileName = config["io"]["preProcessedFile"];
-    if (inputFile.compare("stdin") != 0)
-    {
-        freopen(inputFile.c_str(), "r", stdin);
-    }
-    if (outputFile.compare("stdout") != 0)
-    {
-        freopen(outputFile.c_str(), "w", stdout);
-    }
-    if (errorFile.compare("stderr") != 0)
-    {
-        freopen(errorFile.c_str(), "w", stderr);
-    }
-
-    // Configure the keywords, data types, operators and error messages
-    keywords[config["keywords"]["let"]] = LET;
-    keywords[config["keywords"]["is"]] = IS;
-    keywords[config["keywords"]["if"]] = IF;
-    keywords[config["keywords"]["else"]] = ELSE;
-    keywords[config["keywords"]["then"]] = THEN;
-    keywords[config["keywords"]["skip"]] = SKIP;
-    keywords[config["keywords"]["stop"]] = STOP;
-    keywords[config["keywords"]["do"]] = DO;
-    keywords[config["keywords"]["while"]] = WHILE;
-    keywords[config["keywords"]["escape"]] = ESCAPE;
-    keywords[config["keywords"]["recheck"]] = RECHECK;
-    keywords[config["keywords"]["tillhere"]] = TILLHERE;
-    keywords[config["keywords"]["and"]] = AND;
-    keywords[config["keywords"]["goto"]] = GOTO;
-    keywords[config["keywords"]["read"]] = READ;
-    keywords[config["keywords"]["print"]] = PRINT;
-    keywords[config["keywords"]["newline"]] = NEWLINE;
-    keywords[config["keywords"]["leave"]] = LEAVE;
-    keywords[config["keywords"]["end"]] = END;
-    keywords[config["keywords"]["subroutine"]] = SUBROUTINE;
-
-    keywordsToString[LET] = config["keywords"]["let"];
-    keywordsToString[IS] = config["keywords"]["is"];
-    keywordsToString[IF] = config["keywords"]["if"];
-    keywordsToString[ELSE] = config["keywords"]["else"];
-    keywordsToString[THEN] = config["keywords"]["then"];
-    keywordsToString[SKIP] = config["keywords"]["skip"];
-    keywordsToString[STOP] = config["keywords"]["stop"];
-    keywordsToString[DO] = config["keywords"]["do"];
-    keywordsToString[WHILE] = config["keywords"]["while"];
-    keywordsToString[ESCAPE] = config["keywords"]["escape"];
-    keywordsToString[RECHECK] = config["keywords"]["recheck"];
-    keywordsToString[TILLHERE] = config["keywords"]["tillhere"];
-    keywordsToString[AND] = config["keywords"]["and"];
-    keywordsToString[GOTO] = config["keywords"]["goto"];
-    keywordsToString[READ] = config["keywords"]["read"];
-    keywordsToString[PRINT] = config["keywords"]["print"];
-    keywordsToString[NEWLINE] = config["keywords"]["newline"];
-    keywordsToString[LEAVE] = config["keywords"]["leave"];
-    keywordsToString[END] = config["keywords"]["end"];
-    keywordsToString[SUBROUTINE] = config["keywords"]["subroutine"];
-
-    dataTypes[config["datatypes"]["integer"]] = INTEGER;
-    dataTypes[config["datatypes"]["text"]] = TEXT;
-    dataTypes[config["datatypes"]["real"]] = REAL;
-    dataTypes[config["datatypes"]["integerArray"]] = INTEGER_ARRAY;
-    dataTypes[config["datatypes"]["textArray"]] = TEXT_ARRAY;
-    dataTypes[config["datatypes"]["realArray"]] = REAL_ARRAY;
-
-    dataTypeToString[INTEGER] = config["datatypes"]["integer"];
-    dataTypeToString[TEXT] = config["datatypes"]["text"];
-    dataTypeToString[REAL] = config["datatypes"]["real"];
-    dataTypeToString[INTEGER_ARRAY] = config["datatypes"]["integerArray"];
-    dataTypeToString[TEXT_ARRAY] = config["datatypes"]["textArray"];
-    dataTypeToString[REAL_ARRAY] = config["datatypes"]["realArray"];
-
-    mathOperators[config["operators"]["math"]["plus"]] = PLUS;
-    mathOperators[config["operators"]["math"]["minus"]] = MINUS;
-    mathOperators[config["operators"]["math"]["into"]] = INTO;
-    mathOperators[config["operators"]["math"]["upon"]] = UPON;
-    mathOperators[config["operators"]["math"]["modulo"]] = MODULO;
-    mathOperators[config["operators"]["math"]["exponent"]] = EXPONENT;
-
-    logicalOperators[config["operators"]["logic"]["equals"]] = EQUAL_TO;
-    logicalOperators[config["operators"]["logic"]["notEquals"]] = NOT_EQUAL_TO;
-    logicalOperators[config["operators"]["logic"]["greaterThan"]] = GREATER_THAN;
-    logicalOperators[config["operators"]["logic"]["lessThan"]] = LESS_THAN;
-
-    errorMassage[INVALID_SYNTAX] = config["errorMessages"]["invalidSyntax"];
-    errorMassage[INVALID_DATA_TYPE] = config["errorMessages"]["invalidDatatype"];
-    errorMassage[INVALID_OPERATOR] = config["errorMessages"]["invalidOperator"];
-    errorMassage[INDEX_OUT_OF_BOUNDS] = config["errorMessages"]["indexOutOfBounds"];
-    errorMassage[INVALID_NAME] = config["errorMessages"]["invalidVariableName"];
-    errorMassage[VARIABLE_NOT_FOUND] = config["errorMessages"]["variableNotFound"];
-
-    DEFAULT_ARRAY_SIZE = config["defaults"]["arraySize"];
-    DEFAULT_INTEGER_VALUE = config["defaults"]["integerValue"];
-    DEFAULT_REAL_VALUE = config["defaults"]["realValue"];
-    DEFAULT_TEXT_VALUE = config["defaults"]["textValue"];
+// Keep a number literal and convert it once, so that running the code never parses it again
+int internNumber(string &word)
+{
+    Number number;
+    number.integer = 0;
+    number.real = 0.0;
+    number.integerValid = 1;
+    number.realValid = 1;
+    number.isReal = isReal(word);
+    try
+    {
+        number.integer = stoi(word);
+    }
+    catch (exception &)
+    {
+        number.integerValid = 0;
+    }
+    try
+    {
+        number.real = stod(word);
+    }
+    catch (exception &)
+    {
+        number.realValid = 0;
+    }
+    numberLiterals.push_back(word);
+    numbers.push_back(number);
+    return numbers.size() - 1;
+}
+
+// Parser functions
+
+// Parse a tokenized line into the statements chained with and
+void parse(vector<Token> &tokens, vector<Statement> &statements)
+{
+    combineReductions(tokens);
+    size_t position = 0;
+    while (position < tokens.size())
+    {
+        parseBlock(tokens, position, statements);
+
+        // A block closing keyword which does not close anything is reported when it is reached
+        if (position < tokens.size())
+        {
+            Statement statement = newStatement(INVALID_STATEMENT);
+            statement.error = VARIABLE_NOT_FOUND;
+            statements.push_back(statement);
+            position++;
+            skipStatement(tokens, position);
+        }
+    }
+}
+
+// Parse statements chained with and until else, stop or till-here closes the block
+void parseBlock(vector<Token> &tokens, size_t &position, vector<Statement> &statements)
+{
+    while (position < tokens.size())
+    {
+        // Empty statements are allowed, for example "and stop"
+        if (isKeyword(tokens[position], AND))
+        {
+            position++;
+            continue;
+        }
+        if (closesBlock(tokens[position]))
+        {
+            return;
+        }
+        statements.push_back(parseStatement(tokens, position));
+
+        // Anything left between the end of an if or while and the next and is ignored
+        skipStatement(tokens, position);
+    }
+}
+
+Statement parseStatement(vector<Token> &tokens, size_t &position)
+{
+    Token &first = tokens[position++];
+
+    // variable is expression
+    if (first.type != KEYWORD_TOKEN)
+    {
+        Statement statement = newStatement(ASSIGN_STATEMENT);
+        statement.target = first;
+        if (position < tokens.size() && isKeyword(tokens[position], IS))
+        {
+            position++;
+        }
+        else
+        {
+            statement.error = INVALID_SYNTAX;
+        }
+        readExpression(tokens, position, statement.value);
+        return statement;
+    }
+
+    switch (first.id)
+    {
+    case LET:
+    {
+        // let dataType name is value
+        Statement statement = newStatement(LET_STATEMENT);
+        if (position < tokens.size() && tokens[position].type == DATA_TYPE_TOKEN)
+        {
+            statement.dataType = tokens[position++].id;
+        }
+        else
+        {
+            statement.error = INVALID_DATA_TYPE;
+        }
+
+        // Arrays carry their size in the name (name-size)
+        if (statement.error == -1 && position < tokens.size() && tokens[position].type == IDENTIFIER_TOKEN)
+        {
+            statement.target = tokens[position++];
+            string name = identifierNames[statement.target.id];
+            if (statement.dataType == INTEGER_ARRAY || statement.dataType == TEXT_ARRAY || statement.dataType == REAL_ARRAY)
+            {
+                name = name.substr(0, name.find('-'));
+            }
+            if (validateName(name) == 0)
+            {
+                statement.error = INVALID_NAME;
+            }
+        }
+        else if (statement.error == -1)
+        {
+            statement.error = INVALID_NAME;
+        }
+
+        // The value is optional
+        if (statement.error == -1 && position < tokens.size() && !endsStatement(tokens[position]))
+        {
+            if (isKeyword(tokens[position], IS))
+            {
+                position++;
+                readExpression(tokens, position, statement.value);
+            }
+            else
+            {
+                statement.error = INVALID_SYNTAX;
+            }
+        }
+        return statement;
+    }
+    case PRINT:
+    case READ:
+    {
+        // print value then value then ....
+        Statement statement = newStatement(isKeyword(first, PRINT) ? PRINT_STATEMENT : READ_STATEMENT);
+        while (position < tokens.size() && !endsStatement(tokens[position]))
+        {
+            statement.items.push_back(tokens[position++]);
+            if (position >= tokens.size() || endsStatement(tokens[position]))
+            {
+                break;
+            }
+            if (!isKeyword(tokens[position], THEN))
+            {
+                statement.error = INVALID_SYNTAX;
+                break;
+            }
+            position++;
+        }
+        return statement;
+    }
+    case IF:
+    {
+        // if condition then expression else expression stop
+        Statement statement = newStatement(IF_STATEMENT);
+        parseCondition(tokens, position, THEN, statement.condition);
+        parseBlock(tokens, position, statement.body);
+        if (position < tokens.size() && isKeyword(tokens[position], ELSE))
+        {
+            position++;
+            parseBlock(tokens, position, statement.otherwise);
+        }
+        if (position < tokens.size() && isKeyword(tokens[position], STOP))
+        {
+            position++;
+        }
+        return statement;
+    }
+    case WHILE:
+    {
+        // while condition do expression and expression till-here
+        Statement statement = newStatement(WHILE_STATEMENT);
+        parseCondition(tokens, position, DO, statement.condition);
+        parseBlock(tokens, position, statement.body);
+        if (position < tokens.size() && isKeyword(tokens[position], TILLHERE))
+        {
+            position++;
+        }
+        return statement;
+    }
+    case GOTO:
+    {
+        // goto subroutine-name
+        Statement statement = newStatement(GOTO_STATEMENT);
+        if (position < tokens.size())
+        {
+            statement.target = tokens[position];
+        }
+        return statement;
+    }
+    case LEAVE:
+    {
+        // The rest of the block is a comment
+        while (position < tokens.size() && !closesBlock(tokens[position]))
+        {
+            position++;
+        }
+        return newStatement(SKIP_STATEMENT);
+    }
+    case SKIP:
+        return newStatement(SKIP_STATEMENT);
+    case END:
+        return newStatement(END_STATEMENT);
+    case ESCAPE:
+        return newStatement(ESCAPE_STATEMENT);
+    case RECHECK:
+        return newStatement(RECHECK_STATEMENT);
+    default:
+    {
+        // Any other keyword can not start a statement
+        Statement statement = newStatement(INVALID_STATEMENT);
+        statement.error = VARIABLE_NOT_FOUND;
+        return statement;
+    }
+    }
+}
+
+// Parse "leftHalf is logic rightHalf" up to the keyword which ends the condition
+void parseCondition(vector<Token> &tokens, size_t &position, int closing, Condition &condition)
+{
+    while (position < tokens.size() && !isKeyword(tokens[position], closing) && !isKeyword(tokens[position], IS))
+    {
+        condition.left.push_back(tokens[position++]);
+    }
+    if (position < tokens.size() && isKeyword(tokens[position], IS))
+    {
+        position++;
+        if (position < tokens.size() && tokens[position].type == OPERATOR_TOKEN)
+        {
+            condition.logic = tokens[position].id;
+        }
+        if (position < tokens.size() && !isKeyword(tokens[position], closing))
+        {
+            position++;
+        }
+    }
+    while (position < tokens.size() && !isKeyword(tokens[position], closing))
+    {
+        condition.right.push_back(tokens[position++]);
+    }
+
+    // Skip the closing keyword
+    if (position < tokens.size())
+    {
+        position++;
+    }
+}
+
+// Copy the operands and operators of an expression until the statement ends
+void readExpression(vector<Token> &tokens, size_t &position, vector<Token> &expr)
+{
+    while (position < tokens.size() && !endsStatement(tokens[position]))
+    {
+        expr.push_back(tokens[position++]);
+    }
+}
+
+// Move the cursor to the and which starts the next statement, or to the end of the block
+void skipStatement(vector<Token> &tokens, size_t &position)
+{
+    while (position < tokens.size() && !endsStatement(tokens[position]))
+    {
+        position++;
+    }
+}
+
+Statement newStatement(int type)
+{
+    Statement statement;
+    statement.type = type;
+    statement.error = -1;
+    statement.dataType = -1;
+    statement.target.type = -1;
+    statement.target.id = -1;
+    statement.condition.logic = -1;
+    return statement;
+}
+
+// Resolver functions
+
+// Give every variable used by the statements its slot before they run
+// Slots are only made here and by the compiler, so the addresses taken while interpreting stay valid
+void resolve(vector<Statement> &statements)
+{
+    for (auto &statement : statements)
+    {
+        foldConstants(statement.value);
+        foldConstants(statement.condition.left);
+        foldConstants(statement.condition.right);
+        toPostfix(statement.value, statement.postfix);
+        toPostfix(statement.condition.left, statement.condition.leftPostfix);
+        toPostfix(statement.condition.right, statement.condition.rightPostfix);
+
+        // An array declared without a size
+        int type = statement.dataType;
+        if (statement.type == LET_STATEMENT && (type == INTEGER_ARRAY || type == TEXT_ARRAY || type == REAL_ARRAY) && statement.target.type == IDENTIFIER_TOKEN && identifierNames[statement.target.id].find('-') == string::npos)
+        {
+            arrayOf(statement.target.id);
+            continue;
+        }
+
+        resolve(statement.target);
+        for (auto &token : statement.value)
+        {
+            resolve(token);
+        }
+        for (auto &token : statement.items)
+        {
+            resolve(token);
+        }
+        for (auto &token : statement.condition.left)
+        {
+            resolve(token);
+        }
+        for (auto &token : statement.condition.right)
+        {
+            resolve(token);
+        }
+        resolve(statement.body);
+        resolve(statement.otherwise);
+    }
+}
+
+// Stop with an error at a goto whose subroutine is not defined, the error is reported at the given line
+void checkCalls(vector<Statement> &statements, int line)
+{
+    for (auto &statement : statements)
+    {
+        if (statement.type == GOTO_STATEMENT && (statement.target.type != IDENTIFIER_TOKEN || identifierSubroutines[statement.target.id] == -1))
+        {
+            currentLine = line;
+            printError(SUBROUTINE_NOT_FOUND);
+        }
+        checkCalls(statement.body, line);
+        checkCalls(statement.otherwise, line);
+    }
+}
+
+// Array elements are resolved to their array and the slot of their index, variables to their slot
+void resolve(Token &token)
+{
+    if (token.type == REDUCTION_TOKEN)
+    {
+        arrayOf(reductions[token.id].identifier);
+        return;
+    }
+    if (token.type != IDENTIFIER_TOKEN)
+    {
+        return;
+    }
+    if (identifierNames[token.id].find('-') != string::npos)
+    {
+        elementOf(token.id);
+    }
+    else
+    {
+        slotOf(token.id);
+    }
+}
+
+// Solve the literals at the end of an expression into one literal before it runs
+// The operators are applied from right to left, so "x plus 2 exponent 10" becomes x plus 1024
+void foldConstants(vector<Token> &expr)
+{
+    // The expression must end with an operand
+    if (expr.size() % 2 == 0)
+    {
+        return;
+    }
+    int start = expr.size() - 1;
+    Token folded = expr[start];
+
+    if (folded.type == NUMBER_TOKEN)
+    {
+        Number result = numbers[folded.id];
+        if (!result.integerValid || !result.realValid)
+        {
+            return;
+        }
+        while (start >= 2 && expr[start - 1].type == OPERATOR_TOKEN && expr[start - 2].type == NUMBER_TOKEN)
+        {
+            Number step;
+            if (!foldNumbers(numbers[expr[start - 2].id], expr[start - 1].id, result, step))
+            {
+                break;
+            }
+            result = step;
+            start -= 2;
+        }
+
+        // A folded number has no literal of its own
+        folded.id = numbers.size();
+        numberLiterals.push_back("");
+        numbers.push_back(result);
+    }
+    else if (folded.type == STRING_TOKEN)
+    {
+        string result = textLiterals[folded.id];
+        while (start >= 2 && expr[start - 1].type == OPERATOR_TOKEN && expr[start - 1].id == PLUS && expr[start - 2].type == STRING_TOKEN)
+        {
+            result = textLiterals[expr[start - 2].id] + result;
+            start -= 2;
+        }
+        folded.id = textLiterals.size();
+        textLiterals.push_back(result);
+    }
+
+    if (start == (int)expr.size() - 1)
+    {
+        return;
+    }
+    expr.resize(start + 1);
+    expr[start] = folded;
+}
+
+// Order an expression for the tree walker, its operators are checked here so that solving only applies them
+void toPostfix(vector<Token> &expr, Postfix &postfix)
+{
+    postfix.steps.clear();
+    postfix.error = -1;
+    postfix.textOperands = -1;
+
+    // The operands from left to right, an operator which can not be used ends the expression there
+    vector<Token> operators;
+    for (size_t position = 0; position < expr.size(); position += 2)
+    {
+        postfix.steps.push_back(expr[position]);
+        if (position + 1 == expr.size())
+        {
+            break;
+        }
+
+        Token &op = expr[position + 1];
+        if (postfix.textOperands == -1 && (op.type != OPERATOR_TOKEN || op.id != PLUS))
+        {
+            postfix.textOperands = postfix.steps.size();
+        }
+        if (op.type != OPERATOR_TOKEN || op.id < PLUS || op.id > EXPONENT)
+        {
+            postfix.error = INVALID_SYNTAX;
+            break;
+        }
+        operators.push_back(op);
+
+        // A missing last operand counts as zero
+        if (position + 2 == expr.size())
+        {
+            Token missing;
+            missing.type = -1;
+            missing.id = -1;
+            postfix.steps.push_back(missing);
+        }
+    }
+
+    // Then the operators from right to left, so that "a minus b minus c" is a - (b - c)
+    if (postfix.error == -1)
+    {
+        postfix.steps.insert(postfix.steps.end(), operators.rbegin(), operators.rend());
+    }
+
+    // The stacks are as deep as the longest expression, so solving never grows them
+    if (postfix.steps.size() > integerStack.size())
+    {
+        integerStack.resize(postfix.steps.size());
+        realStack.resize(postfix.steps.size());
+        textStack.resize(postfix.steps.size());
+    }
+}
+
+// Apply an operator to two numbers for both the integer and the real value
+// Return false if the integer result would fail or overflow, so that it is left to the running program
+int foldNumbers(Number &left, int op, Number &right, Number &result)
+{
+    if (!left.integerValid || !left.realValid)
+    {
+        return false;
+    }
+
+    // A condition starting with the result is compared the way it was before folding
+    result.isReal = left.isReal;
+    result.integerValid = 1;
+    result.realValid = 1;
+
+    long long integer = 0;
+    switch (op)
+    {
+    case PLUS:
+        integer = (long long)left.integer + right.integer;
+        result.real = left.real + right.real;
+        break;
+    case MINUS:
+        integer = (long long)left.integer - right.integer;
+        result.real = left.real - right.real;
+        break;
+    case UPON:
+        if (right.integer == 0)
+        {
+            return false;
+        }
+        integer = (long long)left.integer / right.integer;
+        result.real = left.real / right.real;
+        break;
+    case INTO:
+        integer = (long long)left.integer * right.integer;
+        result.real = left.real * right.real;
+        break;
+    case MODULO:
+        if (right.integer == 0)
+        {
+            return false;
+        }
+        integer = (long long)left.integer % right.integer;
+        result.real = fmod(left.real, right.real);
+        break;
+    case EXPONENT:
+        // The power wraps around the same way when the program runs
+        integer = power(left.integer, right.integer);
+        result.real = pow(left.real, right.real);
+        break;
+    default:
+        return false;
+    }
+    if (integer < INT_MIN || integer > INT_MAX)
+    {
+        return false;
+    }
+    result.integer = integer;
+    return true;
+}
+
+// The slot of a variable, it is made the first time the variable is resolved
+int slotOf(int identifier)
+{
+    if (identifierSlots[identifier] == -1)
+    {
+        identifierSlots[identifier] = newSlot(0);
+    }
+    return identifierSlots[identifier];
+}
+
+// The handle of the array of a name, it is made the first time the name is resolved or compiled as an array
+// The array has no type until it is declared while running
+int arrayOf(int identifier)
+{
+    if (identifierArrays[identifier] == -1)
+    {
+        identifierArrays[identifier] = arrays.size();
+        arrays.push_back(Array());
+        arrays.back().types = 0;
+    }
+    return identifierArrays[identifier];
+}
+
+// The element a name like arr-i refers to, the index is a number, a variable or another element
+int elementOf(int identifier)
+{
+    if (identifierElements[identifier] == -1)
+    {
+        string &name = identifierNames[identifier];
+        string arrayName = name.substr(0, name.find('-'));
+        string indexName = name.substr(name.find('-') + 1);
+
+        Element element;
+        element.array = arrayOf(internIdentifier(arrayName));
+        element.index = -1;
+        element.element = -1;
+        element.error = -1;
+        if (indexName.empty())
+        {
+            // A missing index counts as zero like a missing operand
+            element.index = constantSlot(0);
+        }
+        else if (isNumber(indexName))
+        {
+            Number &number = numbers[internNumber(indexName)];
+            if (number.integerValid)
+            {
+                element.index = constantSlot(number.integer);
+            }
+            else
+            {
+                element.error = INVALID_SYNTAX;
+            }
+        }
+        else if (indexName.find('-') != string::npos)
+        {
+            element.element = elementOf(internIdentifier(indexName));
+        }
+        else
+        {
+            element.index = slotOf(internIdentifier(indexName));
+        }
+        elements.push_back(element);
+        identifierElements[identifier] = elements.size() - 1;
+    }
+    return identifierElements[identifier];
+}
+
+// Make a slot which holds values of the given data types
+int newSlot(int types)
+{
+    Slot slot;
+    slot.types = types;
+    slot.integer = 0;
+    slot.real = 0.0;
+    slots.push_back(slot);
+    return slots.size() - 1;
+}
+
+// Inliner functions
+
+// Replace the calls to the subroutines of at most INLINE_SIZE statements with their bodies
+// Only the bodies as they were defined are copied, so a subroutine calling itself is not unrolled
+void inlineSubroutines(vector<vector<Statement>> &lines)
+{
+    vector<vector<Statement>> bodies(subroutines.size());
+    vector<int> inlined(subroutines.size(), false);
+    for (size_t i = 0; i < subroutines.size(); i++)
+    {
+        int size = 0, leaves = false;
+        for (auto &line : subroutines[i].lines)
+        {
+            size += countStatements(line);
+            leaves = leaves || leavesBlock(line);
+        }
+
+        // escape and recheck outside of a loop end the subroutine or its line, a copy could not do that
+        if (size > INLINE_SIZE || leaves)
+        {
+            continue;
+        }
+        for (auto &line : subroutines[i].lines)
+        {
+            bodies[i].insert(bodies[i].end(), line.begin(), line.end());
+        }
+        inlined[i] = true;
+    }
+
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        inlineCalls(lines[i], bodies, inlined, "line " + to_string(i + 1));
+    }
+    for (size_t i = 0; i < identifierSubroutines.size(); i++)
+    {
+        int subroutine = identifierSubroutines[i];
+        if (subroutine == -1)
+        {
+            continue;
+        }
+        for (size_t j = 0; j < subroutines[subroutine].lines.size(); j++)
+        {
+            inlineCalls(subroutines[subroutine].lines[j], bodies, inlined, "subroutine " + identifierNames[i] + " line " + to_string(j + 1));
+        }
+    }
+}
+
+void inlineCalls(vector<Statement> &statements, vector<vector<Statement>> &bodies, vector<int> &inlined, string site)
+{
+    vector<Statement> result;
+    for (auto &statement : statements)
+    {
+        inlineCalls(statement.body, bodies, inlined, site);
+        inlineCalls(statement.otherwise, bodies, inlined, site);
+
+        // Calls to subroutines which are not defined are reported after inlining
+        int subroutine = -1;
+        if (statement.type == GOTO_STATEMENT && statement.target.type == IDENTIFIER_TOKEN)
+        {
+            subroutine = identifierSubroutines[statement.target.id];
+        }
+        if (subroutine == -1 || !inlined[subroutine])
+        {
+            result.push_back(statement);
+            continue;
+        }
+        result.insert(result.end(), bodies[subroutine].begin(), bodies[subroutine].end());
+        if (inlineReport)
+        {
+            cerr << "Inlined " << identifierNames[statement.target.id] << " at " << site << endl;
+        }
+    }
+    statements.swap(result);
+}
+
+// The number of statements in a block and in the blocks inside it
+int countStatements(vector<Statement> &statements)
+{
+    int count = statements.size();
+    for (auto &statement : statements)
+    {
+        count += countStatements(statement.body) + countStatements(statement.otherwise);
+    }
+    return count;
+}
+
+// Whether escape or recheck can be reached outside of a loop
+int leavesBlock(vector<Statement> &statements)
+{
+    for (auto &statement : statements)
+    {
+        if (statement.type == ESCAPE_STATEMENT || statement.type == RECHECK_STATEMENT)
+        {
+            return true;
+        }
+        if (statement.type == IF_STATEMENT && (leavesBlock(statement.body) || leavesBlock(statement.otherwise)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Compiler functions
+
+// Compile the lines of the main program and all the subroutines into one block of code
+void compile(vector<vector<Statement>> &lines, Bytecode &bytecode)
+{
+    // The types of the variables decide which instructions solve the expressions
+    for (auto &line : lines)
+    {
+        collectTypes(line);
+    }
+    for (auto &subroutine : subroutines)
+    {
+        for (auto &line : subroutine.lines)
+        {
+            collectTypes(line);
+        }
+    }
+
+    // The main program counts the lines for the error messages
+    // Outside of a loop escape and recheck jump to the end of their line
+    for (auto &line : lines)
+    {
+        emit(bytecode, NEXT_LINE);
+        escapeJumps.push_back(vector<int>());
+        recheckJumps.push_back(vector<int>());
+        compileBlock(line, bytecode);
+        for (int jump : escapeJumps.back())
+        {
+            patch(bytecode, jump);
+        }
+        for (int jump : recheckJumps.back())
+        {
+            patch(bytecode, jump);
+        }
+        escapeJumps.pop_back();
+        recheckJumps.pop_back();
+    }
+    emit(bytecode, RETURN);
+
+    // In a subroutine escape jumps straight to its return instead
+    vector<int> addresses;
+    for (auto &subroutine : subroutines)
+    {
+        addresses.push_back(bytecode.code.size());
+        vector<int> returns;
+        for (auto &line : subroutine.lines)
+        {
+            escapeJumps.push_back(vector<int>());
+            recheckJumps.push_back(vector<int>());
+            compileBlock(line, bytecode);
+            returns.insert(returns.end(), escapeJumps.back().begin(), escapeJumps.back().end());
+            for (int jump : recheckJumps.back())
+            {
+                patch(bytecode, jump);
+            }
+            escapeJumps.pop_back();
+            recheckJumps.pop_back();
+        }
+        for (int jump : returns)
+        {
+            patch(bytecode, jump);
+        }
+        emit(bytecode, RETURN);
+    }
+
+    // Every call was checked to have its subroutine when the program was loaded
+    for (auto &call : bytecode.calls)
+    {
+        bytecode.code[call.first] = addresses[call.second];
+    }
+    bytecode.calls.clear();
+}
+
+void compileBlock(vector<Statement> &statements, Bytecode &bytecode)
+{
+    for (auto &statement : statements)
+    {
+        compileStatement(statement, bytecode);
+    }
+}
+
+void compileStatement(Statement &statement, Bytecode &bytecode)
+{
+    // Temporary values never live longer than the statement which needs them
+    temporariesUsed[INTEGER] = temporariesUsed[TEXT] = temporariesUsed[REAL] = 0;
+
+    switch (statement.type)
+    {
+    case ASSIGN_STATEMENT:
+    {
+        // Only identifiers can name a variable
+        if (statement.target.type != IDENTIFIER_TOKEN)
+        {
+            emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+            break;
+        }
+
+        string name = identifierNames[statement.target.id];
+        int element = name.find('-') != string::npos;
+        int array = -1, index = -1, slot = -1;
+        if (element)
+        {
+            string arrayName = name.substr(0, name.find('-'));
+            array = arrayOf(internIdentifier(arrayName));
+            index = compileIndex(name.substr(name.find('-') + 1), bytecode);
+        }
+        else
+        {
+            slot = slotOf(statement.target.id);
+        }
+
+        // If the IS keyword was missing
+        if (statement.error != -1)
+        {
+            if (element)
+            {
+                emit(bytecode, CHECK_ELEMENT, array, index);
+            }
+            else
+            {
+                emit(bytecode, CHECK_VARIABLE, slot);
+            }
+            emit(bytecode, RAISE, statement.error);
+            break;
+        }
+
+        // A variable declared with one type is solved straight into its slot
+        int type = staticType(statement.target);
+        if (type != -1)
+        {
+            if (element && uncheckedElements.count(&statement.target))
+            {
+                int value = compileExpression(statement.value, type, -1, bytecode);
+                emit(bytecode, type == INTEGER ? STORE_INTEGER_ELEMENT_UNCHECKED : type == TEXT ? STORE_TEXT_ELEMENT_UNCHECKED : STORE_REAL_ELEMENT_UNCHECKED, array, index, value);
+            }
+            else if (element)
+            {
+                int value = compileExpression(statement.value, type, -1, bytecode);
+                emit(bytecode, type == INTEGER ? STORE_INTEGER_ELEMENT : type == TEXT ? STORE_TEXT_ELEMENT : STORE_REAL_ELEMENT, array, index, value);
+            }
+            else
+            {
+                compileExpression(statement.value, type, slot, bytecode);
+            }
+            break;
+        }
+
+        // Otherwise choose the instructions by the type the variable has when it is reached
+        if (element)
+        {
+            emit(bytecode, SWITCH_ELEMENT_TYPE, array, index);
+        }
+        else
+        {
+            emit(bytecode, SWITCH_TYPE, slot);
+        }
+        int cases = emitCases(bytecode);
+        vector<int> exits;
+        for (int type : {INTEGER, TEXT, REAL})
+        {
+            patch(bytecode, cases + type);
+            if (element)
+            {
+                int value = compileExpression(statement.value, type, -1, bytecode);
+                emit(bytecode, type == INTEGER ? STORE_INTEGER_ELEMENT : type == TEXT ? STORE_TEXT_ELEMENT : STORE_REAL_ELEMENT, array, index, value);
+            }
+            else
+            {
+                compileExpression(statement.value, type, slot, bytecode);
+            }
+            exits.push_back(emit(bytecode, JUMP, -1));
+        }
+        for (int exit : exits)
+        {
+            patch(bytecode, exit);
+        }
+        break;
+    }
+    case LET_STATEMENT:
+    {
+        // Report the errors found while parsing
+        if (statement.error != -1)
+        {
+            emit(bytecode, RAISE, statement.error);
+            break;
+        }
+
+        int type = statement.dataType;
+        string name = identifierNames[statement.target.id];
+        if (type == INTEGER_ARRAY || type == TEXT_ARRAY || type == REAL_ARRAY)
+        {
+            // The part before '-' is the name and after is the size
+            string arrayName = name;
+            int size = -1;
+            if (name.find('-') != string::npos)
+            {
+                arrayName = name.substr(0, name.find('-'));
+                size = compileIndex(name.substr(name.find('-') + 1), bytecode);
+            }
+            else
+            {
+                size = constantSlot(DEFAULT_ARRAY_SIZE);
+            }
+            emit(bytecode, type == INTEGER_ARRAY ? DECLARE_INTEGER_ARRAY : type == TEXT_ARRAY ? DECLARE_TEXT_ARRAY : DECLARE_REAL_ARRAY, arrayOf(internIdentifier(arrayName)), size);
+            break;
+        }
+
+        int value = -1;
+        if (statement.value.empty())
+        {
+            value = type == INTEGER ? constantSlot(DEFAULT_INTEGER_VALUE) : type == TEXT ? constantSlot(DEFAULT_TEXT_VALUE) : constantSlot(DEFAULT_REAL_VALUE);
+        }
+        else
+        {
+            value = compileExpression(statement.value, type, -1, bytecode);
+        }
+        emit(bytecode, type == INTEGER ? DECLARE_INTEGER : type == TEXT ? DECLARE_TEXT : DECLARE_REAL, slotOf(statement.target.id), value);
+        break;
+    }
+    case PRINT_STATEMENT:
+    case READ_STATEMENT:
+    {
+        for (auto &value : statement.items)
+        {
+            if (statement.type == PRINT_STATEMENT && value.type == STRING_TOKEN)
+            {
+                emit(bytecode, PRINT_LITERAL, value.id);
+                continue;
+            }
+            if (statement.type == PRINT_STATEMENT && value.type == REDUCTION_TOKEN)
+            {
+                emit(bytecode, PRINT_REDUCTION, reductions[value.id].kind, arrayOf(reductions[value.id].identifier));
+                continue;
+            }
+            if (value.type != IDENTIFIER_TOKEN)
+            {
+                emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+                continue;
+            }
+
+            string name = identifierNames[value.id];
+            if (name.find('-') != string::npos)
+            {
+                string arrayName = name.substr(0, name.find('-'));
+                int index = compileIndex(name.substr(name.find('-') + 1), bytecode);
+                if (uncheckedElements.count(&value))
+                {
+                    emit(bytecode, statement.type == PRINT_STATEMENT ? PRINT_ELEMENT_UNCHECKED : READ_ELEMENT_UNCHECKED, arrayOf(internIdentifier(arrayName)), index);
+                }
+                else
+                {
+                    emit(bytecode, statement.type == PRINT_STATEMENT ? PRINT_ELEMENT : READ_ELEMENT, arrayOf(internIdentifier(arrayName)), index);
+                }
+            }
+            else if (identifierArrays[value.id] != -1)
+            {
+                // The name of an array without an index reads or prints the whole array, unless it is also a variable
+                emit(bytecode, statement.type == PRINT_STATEMENT ? PRINT_ARRAY : READ_ARRAY, slotOf(value.id), identifierArrays[value.id]);
+            }
+            else
+            {
+                emit(bytecode, statement.type == PRINT_STATEMENT ? PRINT_VARIABLE : READ_VARIABLE, slotOf(value.id));
+            }
+        }
+
+        // If the values were not chained properly
+        if (statement.error != -1)
+        {
+            emit(bytecode, RAISE, statement.error);
+        }
+        break;
+    }
+    case IF_STATEMENT:
+    {
+        // condition jumps to else if false, body, jump over else
+        vector<int> otherwise;
+        compileCondition(statement.condition, otherwise, bytecode);
+        compileBlock(statement.body, bytecode);
+        int exit = -1;
+        if (!statement.otherwise.empty())
+        {
+            exit = emit(bytecode, JUMP, -1);
+        }
+        for (int jump : otherwise)
+        {
+            patch(bytecode, jump);
+        }
+        if (exit != -1)
+        {
+            compileBlock(statement.otherwise, bytecode);
+            patch(bytecode, exit);
+        }
+        break;
+    }
+    case WHILE_STATEMENT:
+    {
+        LoopBounds bounds;
+        if (!versionLoops || !proveBounds(statement, bounds))
+        {
+            compileLoop(statement, bytecode);
+            break;
+        }
+
+        // The loop is compiled twice, checks before it choose the copy without bounds checks when
+        // every array has n elements, i is not negative and i cannot overflow while growing up to n
+        // Only the checked copy compiles its inner loops twice again, so nesting grows the code by one copy per level
+        int index = slotOf(bounds.index);
+        int bound = bounds.bound == -1 ? constantSlot(bounds.limit) : slotOf(bounds.bound);
+        vector<int> fallbacks;
+        for (int array : bounds.arrays)
+        {
+            fallbacks.push_back(emit(bytecode, JUMP_UNLESS_COVERED, array, index, bound, -1));
+        }
+        fallbacks.push_back(emit(bytecode, JUMP_UNLESS_LESS_INTEGER, bound, constantSlot(INT_MAX - bounds.step), -1));
+
+        set<Token *> enclosing = uncheckedElements;
+        uncheckedElements.insert(bounds.elements.begin(), bounds.elements.end());
+        versionLoops = false;
+        compileLoop(statement, bytecode);
+        versionLoops = true;
+        uncheckedElements = enclosing;
+
+        int exit = emit(bytecode, JUMP, -1);
+        for (int fallback : fallbacks)
+        {
+            patch(bytecode, fallback);
+        }
+        compileLoop(statement, bytecode);
+        patch(bytecode, exit);
+        break;
+    }
+    case GOTO_STATEMENT:
+    {
+        // The address of the subroutine is filled in once all of them are compiled
+        bytecode.calls.push_back({emit(bytecode, CALL, -1), identifierSubroutines[statement.target.id]});
+        break;
+    }
+    case END_STATEMENT:
+        emit(bytecode, HALT);
+        break;
+    case ESCAPE_STATEMENT:
+        escapeJumps.back().push_back(emit(bytecode, JUMP, -1));
+        break;
+    case RECHECK_STATEMENT:
+        recheckJumps.back().push_back(emit(bytecode, JUMP, -1));
+        break;
+    case SKIP_STATEMENT:
+        break;
+    default:
+        emit(bytecode, RAISE, statement.error);
+    }
+}
+
+void compileLoop(Statement &statement, Bytecode &bytecode)
+{
+    // escape jumps to the end of the loop and recheck back to the condition, nothing is checked on every pass
+    int start = bytecode.code.size();
+    vector<int> exits;
+    compileCondition(statement.condition, exits, bytecode);
+    escapeJumps.push_back(vector<int>());
+    recheckJumps.push_back(vector<int>());
+    compileBlock(statement.body, bytecode);
+    emit(bytecode, JUMP, start);
+    for (int jump : recheckJumps.back())
+    {
+        bytecode.code[jump] = start;
+    }
+    exits.insert(exits.end(), escapeJumps.back().begin(), escapeJumps.back().end());
+    escapeJumps.pop_back();
+    recheckJumps.pop_back();
+    for (int exit : exits)
+    {
+        patch(bytecode, exit);
+    }
+}
+
+// Jump to the operands added to exits when the condition is false, fall through when it is true
+void compileCondition(Condition &condition, vector<int> &exits, Bytecode &bytecode)
+{
+    // An empty condition is never true
+    if (condition.left.empty())
+    {
+        if (condition.logic != -1)
+        {
+            emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+        }
+        exits.push_back(emit(bytecode, JUMP, -1));
+        return;
+    }
+
+    // The first word of the condition decides how it is compared
+    Token &first = condition.left[0];
+    if (first.type == STRING_TOKEN)
+    {
+        compileComparison(condition, TEXT, exits, bytecode);
+        return;
+    }
+    if (first.type == NUMBER_TOKEN)
+    {
+        compileComparison(condition, numbers[first.id].isReal ? REAL : INTEGER, exits, bytecode);
+        return;
+    }
+    if (first.type == REDUCTION_TOKEN && reductions[first.id].kind == COUNT_OF)
+    {
+        compileComparison(condition, INTEGER, exits, bytecode);
+        return;
+    }
+    if (first.type != IDENTIFIER_TOKEN && first.type != REDUCTION_TOKEN)
+    {
+        emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+        return;
+    }
+
+    int type = staticType(first);
+    if (type != -1)
+    {
+        compileComparison(condition, type, exits, bytecode);
+        return;
+    }
+
+    // The type of the variable or of the elements of the reduced array is only known when the condition is reached
+    string name = first.type == IDENTIFIER_TOKEN ? identifierNames[first.id] : "";
+    if (first.type == REDUCTION_TOKEN)
+    {
+        emit(bytecode, SWITCH_REDUCTION_TYPE, reductions[first.id].kind, arrayOf(reductions[first.id].identifier));
+    }
+    else if (name.find('-') != string::npos)
+    {
+        string arrayName = name.substr(0, name.find('-'));
+        int index = compileIndex(name.substr(name.find('-') + 1), bytecode);
+        emit(bytecode, SWITCH_ELEMENT_TYPE, arrayOf(internIdentifier(arrayName)), index);
+    }
+    else
+    {
+        emit(bytecode, SWITCH_TYPE, slotOf(first.id));
+    }
+    int cases = emitCases(bytecode);
+    vector<int> bodies;
+    for (int type : {INTEGER, TEXT, REAL})
+    {
+        patch(bytecode, cases + type);
+        if (first.type == REDUCTION_TOKEN && type == TEXT)
+        {
+            emit(bytecode, RAISE, INVALID_DATA_TYPE);
+            continue;
+        }
+        compileComparison(condition, type, exits, bytecode);
+        bodies.push_back(emit(bytecode, JUMP, -1));
+    }
+    for (int body : bodies)
+    {
+        patch(bytecode, body);
+    }
+}
+
+void compileComparison(Condition &condition, int type, vector<int> &exits, Bytecode &bytecode)
+{
+    // One instruction compares the two halves and jumps when the condition is false
+    int instruction = -1;
+    switch (condition.logic)
+    {
+    case LESS_THAN:
+        instruction = type == INTEGER ? JUMP_UNLESS_LESS_INTEGER : type == TEXT ? JUMP_UNLESS_LESS_TEXT : JUMP_UNLESS_LESS_REAL;
+        break;
+    case GREATER_THAN:
+        instruction = type == INTEGER ? JUMP_UNLESS_GREATER_INTEGER : type == TEXT ? JUMP_UNLESS_GREATER_TEXT : JUMP_UNLESS_GREATER_REAL;
+        break;
+    case EQUAL_TO:
+        instruction = type == INTEGER ? JUMP_UNLESS_EQUAL_INTEGER : type == TEXT ? JUMP_UNLESS_EQUAL_TEXT : JUMP_UNLESS_EQUAL_REAL;
+        break;
+    case NOT_EQUAL_TO:
+        instruction = type == INTEGER ? JUMP_UNLESS_NOT_EQUAL_INTEGER : type == TEXT ? JUMP_UNLESS_NOT_EQUAL_TEXT : JUMP_UNLESS_NOT_EQUAL_REAL;
+        break;
+    default:
+        emit(bytecode, RAISE, INVALID_OPERATOR);
+        return;
+    }
+
+    // Two literals are compared now, a true condition needs no code and a false one always jumps
+    int constant = constantCondition(condition, type);
+    if (constant != -1)
+    {
+        if (!constant)
+        {
+            exits.push_back(emit(bytecode, JUMP, -1));
+        }
+        return;
+    }
+
+    int left = compileExpression(condition.left, type, -1, bytecode);
+    int right = compileExpression(condition.right, type, -1, bytecode);
+    exits.push_back(emit(bytecode, instruction, left, right, -1));
+}
+
+// Whether a condition of two literals is true, -1 if either half has to be solved while running
+int constantCondition(Condition &condition, int type)
+{
+    if (condition.left.size() != 1 || condition.right.size() != 1)
+    {
+        return -1;
+    }
+    Token &left = condition.left[0], &right = condition.right[0];
+    if (type == TEXT)
+    {
+        if (left.type != STRING_TOKEN || right.type != STRING_TOKEN)
+        {
+            return -1;
+        }
+        int order = textLiterals[left.id].compare(textLiterals[right.id]);
+        switch (condition.logic)
+        {
+        case LESS_THAN:
+            return order < 0;
+        case GREATER_THAN:
+            return order > 0;
+        case EQUAL_TO:
+            return order == 0;
+        case NOT_EQUAL_TO:
+            return order != 0;
+        }
+        return -1;
+    }
+
+    if (left.type != NUMBER_TOKEN || right.type != NUMBER_TOKEN)
+    {
+        return -1;
+    }
+    Number &first = numbers[left.id], &second = numbers[right.id];
+    if (!first.integerValid || !first.realValid || !second.integerValid || !second.realValid)
+    {
+        return -1;
+    }
+    double leftValue = type == INTEGER ? first.integer : first.real;
+    double rightValue = type == INTEGER ? second.integer : second.real;
+    switch (condition.logic)
+    {
+    case LESS_THAN:
+        return leftValue < rightValue;
+    case GREATER_THAN:
+        return leftValue > rightValue;
+    case EQUAL_TO:
+        return leftValue == rightValue;
+    case NOT_EQUAL_TO:
+        return leftValue != rightValue;
+    }
+    return -1;
+}
+
+// Solve an expression into the destination slot, or into any slot when the destination is -1
+// Return the slot which holds the result
+int compileExpression(vector<Token> &expr, int type, int destination, Bytecode &bytecode)
+{
+    // Find the operators, a wrong one ends the expression there
+    vector<int> operators;
+    int valid = 1;
+    for (size_t position = 1; position < expr.size(); position += 2)
+    {
+        int instruction = operatorInstruction(expr[position], type);
+        if (instruction == -1)
+        {
+            valid = 0;
+            break;
+        }
+        operators.push_back(instruction);
+    }
+
+    // The operands are looked at from left to right like in the interpreter
+    vector<int> operands;
+    for (size_t position = 0; position < expr.size() && operands.size() <= operators.size(); position += 2)
+    {
+        operands.push_back(compileOperand(expr[position], type, bytecode));
+    }
+    if (!valid)
+    {
+        for (int operand : operands)
+        {
+            emit(bytecode, CHECK_OPERAND, operand, type);
+        }
+        emit(bytecode, RAISE, INVALID_SYNTAX);
+        return operands.back();
+    }
+
+    // A missing operand at the end counts as zero
+    if (operands.size() == operators.size())
+    {
+        operands.push_back(zeroSlot(type));
+    }
+
+    // Apply the operators from right to left, so that "a minus b minus c" is a - (b - c)
+    // Every step reads its operands before writing, so one temporary slot carries the result
+    int result = operands.back();
+    int temporary = -1;
+    for (int i = operators.size() - 1; i >= 0; i--)
+    {
+        int target = destination;
+        if (i > 0 || destination == -1)
+        {
+            if (temporary == -1)
+            {
+                temporary = temporarySlot(type);
+            }
+            target = temporary;
+        }
+        emit(bytecode, operators[i], target, operands[i], result);
+        result = target;
+    }
+    if (destination != -1 && result != destination)
+    {
+        emit(bytecode, type == INTEGER ? MOVE_INTEGER : type == TEXT ? MOVE_TEXT : MOVE_REAL, destination, result);
+        result = destination;
+    }
+    return result;
+}
+
+// The instruction for an operator in an expression of the type, -1 if the operator can not be used
+int operatorInstruction(Token &op, int type)
+{
+    if (op.type != OPERATOR_TOKEN)
+    {
+        return -1;
+    }
+
+    // Texts can only be joined together
+    if (type == TEXT)
+    {
+        return op.id == PLUS ? JOIN_TEXT : -1;
+    }
+
+    switch (op.id)
+    {
+    case PLUS:
+        return type == INTEGER ? ADD_INTEGER : ADD_REAL;
+    case MINUS:
+        return type == INTEGER ? SUBTRACT_INTEGER : SUBTRACT_REAL;
+    case UPON:
+        return type == INTEGER ? DIVIDE_INTEGER : DIVIDE_REAL;
+    case INTO:
+        return type == INTEGER ? MULTIPLY_INTEGER : MULTIPLY_REAL;
+    case MODULO:
+        return type == INTEGER ? MODULO_INTEGER : MODULO_REAL;
+    case EXPONENT:
+        return type == INTEGER ? POWER_INTEGER : POWER_REAL;
+    }
+    return -1;
+}
+
+// Return the slot which holds the value of an operand
+// Variables are used from their own slots, array elements are loaded into a temporary slot first
+int compileOperand(Token &operand, int type, Bytecode &bytecode)
+{
+    if (operand.type == IDENTIFIER_TOKEN)
+    {
+        string name = identifierNames[operand.id];
+        if (name.find('-') == string::npos)
+        {
+            return slotOf(operand.id);
+        }
+        string arrayName = name.substr(0, name.find('-'));
+        int index = compileIndex(name.substr(name.find('-') + 1), bytecode);
+        int temporary = temporarySlot(type);
+        if (uncheckedElements.count(&operand) && staticType(operand) == type)
+        {
+            emit(bytecode, type == INTEGER ? LOAD_INTEGER_ELEMENT_UNCHECKED : type == TEXT ? LOAD_TEXT_ELEMENT_UNCHECKED : LOAD_REAL_ELEMENT_UNCHECKED, temporary, arrayOf(internIdentifier(arrayName)), index);
+        }
+        else
+        {
+            emit(bytecode, type == INTEGER ? LOAD_INTEGER_ELEMENT : type == TEXT ? LOAD_TEXT_ELEMENT : LOAD_REAL_ELEMENT, temporary, arrayOf(internIdentifier(arrayName)), index);
+        }
+        return temporary;
+    }
+    if (operand.type == NUMBER_TOKEN && type != TEXT)
+    {
+        Number &number = numbers[operand.id];
+        if (type == INTEGER && number.integerValid)
+        {
+            return constantSlot(number.integer);
+        }
+        if (type == REAL && number.realValid)
+        {
+            return constantSlot(number.real);
+        }
+        emit(bytecode, RAISE, INVALID_SYNTAX);
+        return zeroSlot(type);
+    }
+    if (operand.type == STRING_TOKEN && type == TEXT)
+    {
+        return constantSlot(textLiterals[operand.id]);
+    }
+    if (operand.type == REDUCTION_TOKEN && type != TEXT)
+    {
+        int temporary = temporarySlot(type);
+        emit(bytecode, type == INTEGER ? REDUCE_INTEGER : REDUCE_REAL, temporary, reductions[operand.id].kind, arrayOf(reductions[operand.id].identifier));
+        return temporary;
+    }
+    emit(bytecode, RAISE, VARIABLE_NOT_FOUND);
+    return zeroSlot(type);
+}
+
+// Return the slot which holds the index of an array element, which is a single word such as 5, i or idx-j
+int compileIndex(string word, Bytecode &bytecode)
+{
+    Token token;
+    if (word.empty())
+    {
+        // A missing index counts as zero like a missing operand
+        return constantSlot(0);
+    }
+    if (isNumber(word))
+    {
+        token.type = NUMBER_TOKEN;
+        token.id = internNumber(word);
+    }
+    else
+    {
+        token.type = IDENTIFIER_TOKEN;
+        token.id = internIdentifier(word);
+    }
+    return compileOperand(token, INTEGER, bytecode);
+}
+
+// Remember the data types each name is declared with
+void collectTypes(vector<Statement> &statements)
+{
+    for (auto &statement : statements)
+    {
+        if (statement.type == LET_STATEMENT && statement.error == -1)
+        {
+            int identifier = statement.target.id;
+            int type = statement.dataType;
+            if (type == INTEGER_ARRAY || type == TEXT_ARRAY || type == REAL_ARRAY)
+            {
+                identifier = baseOf(identifier);
+            }
+            identifierTypes[identifier] |= 1 << type;
+        }
+        collectTypes(statement.body);
+        collectTypes(statement.otherwise);
+    }
+}
+
+// The identifier of the array a name like arr-i refers to, the name before the first '-' is interned once
+int baseOf(int identifier)
+{
+    if (identifierBases[identifier] == -1)
+    {
+        size_t dash = identifierNames[identifier].find('-');
+        int base = identifier;
+        if (dash != string::npos)
+        {
+            string arrayName = identifierNames[identifier].substr(0, dash);
+            base = internIdentifier(arrayName);
+        }
+        identifierBases[identifier] = base;
+    }
+    return identifierBases[identifier];
+}
+
+// The type a variable or an array element always has, -1 if it can change while running
+int staticType(Token &token)
+{
+    if (token.type != IDENTIFIER_TOKEN)
+    {
+        return -1;
+    }
+    // newline is declared before the program starts
+    if (identifierNames[token.id].compare(keywordsToString.at(NEWLINE)) == 0)
+    {
+        return identifierTypes[token.id] == 0 ? TEXT : -1;
+    }
+
+    // An element has the type of its array
+    int types = 0;
+    int base = baseOf(token.id);
+    if (base != token.id)
+    {
+        int arrayTypes = identifierTypes[base];
+        for (int type : {INTEGER, TEXT, REAL})
+        {
+            if (arrayTypes & (1 << (type + INTEGER_ARRAY)))
+            {
+                types |= 1 << type;
+            }
+        }
+    }
+    else
+    {
+        types = identifierTypes[token.id] & ((1 << INTEGER) | (1 << TEXT) | (1 << REAL));
+    }
+
+    for (int type : {INTEGER, TEXT, REAL})
+    {
+        if (types == 1 << type)
+        {
+            return type;
+        }
+    }
+    return -1;
+}
+
+// Find the array elements of a while loop which are always in bounds
+// The loop has to be while i is less-than n with i and n integers, inside it i only grows by constant steps,
+// n and the arrays are not declared again and no subroutine is called
+// Every arr-i used before i grows in a pass of the body is then in bounds as long as arr has n elements
+int proveBounds(Statement &loop, LoopBounds &bounds)
+{
+    Condition &condition = loop.condition;
+    if (condition.left.size() != 1 || condition.right.size() != 1)
+    {
+        return false;
+    }
+
+    // n greater-than i is the same loop
+    Token *index = &condition.left[0], *bound = &condition.right[0];
+    if (condition.logic == GREATER_THAN)
+    {
+        swap(index, bound);
+    }
+    else if (condition.logic != LESS_THAN)
+    {
+        return false;
+    }
+
+    if (index->type != IDENTIFIER_TOKEN || identifierNames[index->id].find('-') != string::npos || staticType(*index) != INTEGER)
+    {
+        return false;
+    }
+    bounds.index = index->id;
+    bounds.bound = -1;
+    bounds.limit = 0;
+    if (bound->type == NUMBER_TOKEN && !numbers[bound->id].isReal)
+    {
+        if (!numbers[bound->id].integerValid)
+        {
+            return false;
+        }
+        bounds.limit = numbers[bound->id].integer;
+    }
+    else if (bound->type == IDENTIFIER_TOKEN && bound->id != index->id && identifierNames[bound->id].find('-') == string::npos && staticType(*bound) == INTEGER)
+    {
+        bounds.bound = bound->id;
+    }
+    else
+    {
+        return false;
+    }
+
+    bounds.step = 0;
+    if (!scanLoop(loop.body, bounds, 0))
+    {
+        return false;
+    }
+    int unmodified = true;
+    collectElements(loop.body, bounds, unmodified);
+    return !bounds.elements.empty();
+}
+
+// Check that nothing in the loop changes n or moves i back, i may only grow outside of the nested loops
+int scanLoop(vector<Statement> &statements, LoopBounds &bounds, int nested)
+{
+    for (auto &statement : statements)
+    {
+        Token &target = statement.target;
+        switch (statement.type)
+        {
+        case GOTO_STATEMENT:
+            return false;
+        case LET_STATEMENT:
+        {
+            if (target.type != IDENTIFIER_TOKEN || target.id == bounds.index || target.id == bounds.bound)
+            {
+                return false;
+            }
+            int type = statement.dataType;
+            if (type == INTEGER_ARRAY || type == TEXT_ARRAY || type == REAL_ARRAY)
+            {
+                string name = identifierNames[target.id];
+                string arrayName = name.substr(0, name.find('-'));
+                bounds.declared.push_back(arrayOf(internIdentifier(arrayName)));
+            }
+            break;
+        }
+        case READ_STATEMENT:
+            for (auto &item : statement.items)
+            {
+                if (item.type == IDENTIFIER_TOKEN && (item.id == bounds.index || item.id == bounds.bound))
+                {
+                    return false;
+                }
+            }
+            break;
+        case ASSIGN_STATEMENT:
+        {
+            if (target.type != IDENTIFIER_TOKEN || target.id == bounds.bound)
+            {
+                return false;
+            }
+            if (target.id != bounds.index)
+            {
+                break;
+            }
+
+            // i is i plus a whole number
+            vector<Token> &value = statement.value;
+            if (nested || statement.error != -1 || value.size() != 3 || value[0].type != IDENTIFIER_TOKEN || value[0].id != bounds.index || value[1].type != OPERATOR_TOKEN || value[1].id != PLUS || value[2].type != NUMBER_TOKEN || numbers[value[2].id].isReal || !numbers[value[2].id].integerValid)
+            {
+                return false;
+            }
+            int step = numbers[value[2].id].integer;
+            if (step < 0 || step > (1 << 20))
+            {
+                return false;
+            }
+            bounds.step += step;
+            if (bounds.step > (1 << 20))
+            {
+                return false;
+            }
+            break;
+        }
+        case IF_STATEMENT:
+            if (!scanLoop(statement.body, bounds, nested) || !scanLoop(statement.otherwise, bounds, nested))
+            {
+                return false;
+            }
+            break;
+        case WHILE_STATEMENT:
+            if (!scanLoop(statement.body, bounds, nested + 1))
+            {
+                return false;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+// Mark the elements at i which are used before i grows in a pass of the body
+void collectElements(vector<Statement> &statements, LoopBounds &bounds, int &unmodified)
+{
+    for (auto &statement : statements)
+    {
+        if (unmodified)
+        {
+            if (statement.type != LET_STATEMENT)
+            {
+                markElement(statement.target, bounds);
+            }
+            for (auto &token : statement.value)
+            {
+                markElement(token, bounds);
+            }
+            for (auto &token : statement.items)
+            {
+                markElement(token, bounds);
+            }
+            for (auto &token : statement.condition.left)
+            {
+                markElement(token, bounds);
+            }
+            for (auto &token : statement.condition.right)
+            {
+                markElement(token, bounds);
+            }
+        }
+
+        if (statement.type == IF_STATEMENT)
+        {
+            int body = unmodified, otherwise = unmodified;
+            collectElements(statement.body, bounds, body);
+            collectElements(statement.otherwise, bounds, otherwise);
+            unmodified = body && otherwise;
+        }
+        else if (statement.type == WHILE_STATEMENT)
+        {
+            // scanLoop made sure that nested loops do not change i
+            collectElements(statement.body, bounds, unmodified);
+        }
+        else if (statement.type == ASSIGN_STATEMENT && statement.target.id == bounds.index)
+        {
+            unmodified = false;
+        }
+    }
+}
+
+void markElement(Token &token, LoopBounds &bounds)
+{
+    if (token.type != IDENTIFIER_TOKEN)
+    {
+        return;
+    }
+    string name = identifierNames[token.id];
+    size_t dash = name.find('-');
+    if (dash == string::npos || name.compare(dash + 1, string::npos, identifierNames[bounds.index]) != 0)
+    {
+        return;
+    }
+
+    string arrayName = name.substr(0, dash);
+    int array = arrayOf(internIdentifier(arrayName));
+    if (find(bounds.declared.begin(), bounds.declared.end(), array) != bounds.declared.end())
+    {
+        return;
+    }
+    bounds.elements.insert(&token);
+    if (find(bounds.arrays.begin(), bounds.arrays.end(), array) == bounds.arrays.end())
+    {
+        bounds.arrays.push_back(array);
+    }
+}
+
+int constantSlot(int value)
+{
+    int slot = newSlot(1 << INTEGER);
+    slots[slot].integer = value;
+    return slot;
+}
+
+int constantSlot(double value)
+{
+    int slot = newSlot(1 << REAL);
+    slots[slot].real = value;
+    return slot;
+}
+
+int constantSlot(string value)
+{
+    int slot = newSlot(1 << TEXT);
+    slots[slot].text = value;
+    return slot;
+}
+
+// The value of an empty expression
+int zeroSlot(int type)
+{
+    return type == INTEGER ? constantSlot(0) : type == TEXT ? constantSlot(string("")) : constantSlot(0.0);
+}
+
+// Take the next free temporary slot of a type, they are reused by the next statement
+int temporarySlot(int type)
+{
+    if ((size_t)temporariesUsed[type] == temporarySlots[type].size())
+    {
+        temporarySlots[type].push_back(newSlot(1 << type));
+    }
+    return temporarySlots[type][temporariesUsed[type]++];
+}
+
+// The emit functions return the position of the last operand so that a jump can be patched later
+int emit(Bytecode &bytecode, int instruction)
+{
+    bytecode.code.push_back(instruction);
+    return bytecode.code.size() - 1;
+}
+
+int emit(Bytecode &bytecode, int instruction, int first)
+{
+    bytecode.code.push_back(instruction);
+    bytecode.code.push_back(first);
+    return bytecode.code.size() - 1;
+}
+
+int emit(Bytecode &bytecode, int instruction, int first, int second)
+{
+    bytecode.code.push_back(instruction);
+    bytecode.code.push_back(first);
+    bytecode.code.push_back(second);
+    return bytecode.code.size() - 1;
+}
+
+int emit(Bytecode &bytecode, int instruction, int first, int second, int third)
+{
+    bytecode.code.push_back(instruction);
+    bytecode.code.push_back(first);
+    bytecode.code.push_back(second);
+    bytecode.code.push_back(third);
+    return bytecode.code.size() - 1;
+}
+
+int emit(Bytecode &bytecode, int instruction, int first, int second, int third, int fourth)
+{
+    bytecode.code.push_back(instruction);
+    bytecode.code.push_back(first);
+    bytecode.code.push_back(second);
+    bytecode.code.push_back(third);
+    bytecode.code.push_back(fourth);
+    return bytecode.code.size() - 1;
+}
+
+// Add the three addresses of a switch in the order integer, text, real and return the first one
+int emitCases(Bytecode &bytecode)
+{
+    bytecode.code.insert(bytecode.code.end(), {-1, -1, -1});
+    return bytecode.code.size() - 3;
+}
+
+// Point a jump to the end of the code compiled so far
+void patch(Bytecode &bytecode, int operand)
+{
+    bytecode.code[operand] = bytecode.code.size();
+}
+
+// Virtual machine functions
+
+// Every instruction jumps straight to the code of the next one with computed goto, a GCC and Clang
+// extension, so each of them gets its own indirect branch. Other compilers and builds configured
+// with SYMLS_SWITCH_DISPATCH go back through the switch after every instruction.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(SYMLS_SWITCH_DISPATCH)
+#define COMPUTED_GOTO
+#define INSTRUCTION(name) \
+    case name:            \
+    name##_LABEL:
+#define DISPATCH() goto *labels[code[pc]]
+#else
+#define INSTRUCTION(name) case name:
+#define DISPATCH() break
+#endif
+
+void run(const int *code)
+{
+#ifdef COMPUTED_GOTO
+    // The code of every instruction, indexed by the instruction
+    static void *labels[HALT + 1];
+    if (labels[HALT] == nullptr)
+    {
+        labels[ADD_INTEGER] = &&ADD_INTEGER_LABEL;
+        labels[SUBTRACT_INTEGER] = &&SUBTRACT_INTEGER_LABEL;
+        labels[DIVIDE_INTEGER] = &&DIVIDE_INTEGER_LABEL;
+        labels[MULTIPLY_INTEGER] = &&MULTIPLY_INTEGER_LABEL;
+        labels[MODULO_INTEGER] = &&MODULO_INTEGER_LABEL;
+        labels[POWER_INTEGER] = &&POWER_INTEGER_LABEL;
+        labels[ADD_REAL] = &&ADD_REAL_LABEL;
+        labels[SUBTRACT_REAL] = &&SUBTRACT_REAL_LABEL;
+        labels[DIVIDE_REAL] = &&DIVIDE_REAL_LABEL;
+        labels[MULTIPLY_REAL] = &&MULTIPLY_REAL_LABEL;
+        labels[MODULO_REAL] = &&MODULO_REAL_LABEL;
+        labels[POWER_REAL] = &&POWER_REAL_LABEL;
+        labels[JOIN_TEXT] = &&JOIN_TEXT_LABEL;
+        labels[MOVE_INTEGER] = &&MOVE_INTEGER_LABEL;
+        labels[MOVE_REAL] = &&MOVE_REAL_LABEL;
+        labels[MOVE_TEXT] = &&MOVE_TEXT_LABEL;
+        labels[DECLARE_INTEGER] = &&DECLARE_INTEGER_LABEL;
+        labels[DECLARE_REAL] = &&DECLARE_REAL_LABEL;
+        labels[DECLARE_TEXT] = &&DECLARE_TEXT_LABEL;
+        labels[DECLARE_INTEGER_ARRAY] = &&DECLARE_INTEGER_ARRAY_LABEL;
+        labels[DECLARE_REAL_ARRAY] = &&DECLARE_REAL_ARRAY_LABEL;
+        labels[DECLARE_TEXT_ARRAY] = &&DECLARE_TEXT_ARRAY_LABEL;
+        labels[LOAD_INTEGER_ELEMENT] = &&LOAD_INTEGER_ELEMENT_LABEL;
+        labels[LOAD_REAL_ELEMENT] = &&LOAD_REAL_ELEMENT_LABEL;
+        labels[LOAD_TEXT_ELEMENT] = &&LOAD_TEXT_ELEMENT_LABEL;
+        labels[STORE_INTEGER_ELEMENT] = &&STORE_INTEGER_ELEMENT_LABEL;
+        labels[STORE_REAL_ELEMENT] = &&STORE_REAL_ELEMENT_LABEL;
+        labels[STORE_TEXT_ELEMENT] = &&STORE_TEXT_ELEMENT_LABEL;
+        labels[LOAD_INTEGER_ELEMENT_UNCHECKED] = &&LOAD_INTEGER_ELEMENT_UNCHECKED_LABEL;
+        labels[LOAD_REAL_ELEMENT_UNCHECKED] = &&LOAD_REAL_ELEMENT_UNCHECKED_LABEL;
+        labels[LOAD_TEXT_ELEMENT_UNCHECKED] = &&LOAD_TEXT_ELEMENT_UNCHECKED_LABEL;
+        labels[STORE_INTEGER_ELEMENT_UNCHECKED] = &&STORE_INTEGER_ELEMENT_UNCHECKED_LABEL;
+        labels[STORE_REAL_ELEMENT_UNCHECKED] = &&STORE_REAL_ELEMENT_UNCHECKED_LABEL;
+        labels[STORE_TEXT_ELEMENT_UNCHECKED] = &&STORE_TEXT_ELEMENT_UNCHECKED_LABEL;
+        labels[JUMP_UNLESS_LESS_INTEGER] = &&JUMP_UNLESS_LESS_INTEGER_LABEL;
+        labels[JUMP_UNLESS_GREATER_INTEGER] = &&JUMP_UNLESS_GREATER_INTEGER_LABEL;
+        labels[JUMP_UNLESS_EQUAL_INTEGER] = &&JUMP_UNLESS_EQUAL_INTEGER_LABEL;
+        labels[JUMP_UNLESS_NOT_EQUAL_INTEGER] = &&JUMP_UNLESS_NOT_EQUAL_INTEGER_LABEL;
+        labels[JUMP_UNLESS_LESS_REAL] = &&JUMP_UNLESS_LESS_REAL_LABEL;
+        labels[JUMP_UNLESS_GREATER_REAL] = &&JUMP_UNLESS_GREATER_REAL_LABEL;
+        labels[JUMP_UNLESS_EQUAL_REAL] = &&JUMP_UNLESS_EQUAL_REAL_LABEL;
+        labels[JUMP_UNLESS_NOT_EQUAL_REAL] = &&JUMP_UNLESS_NOT_EQUAL_REAL_LABEL;
+        labels[JUMP_UNLESS_LESS_TEXT] = &&JUMP_UNLESS_LESS_TEXT_LABEL;
+        labels[JUMP_UNLESS_GREATER_TEXT] = &&JUMP_UNLESS_GREATER_TEXT_LABEL;
+        labels[JUMP_UNLESS_EQUAL_TEXT] = &&JUMP_UNLESS_EQUAL_TEXT_LABEL;
+        labels[JUMP_UNLESS_NOT_EQUAL_TEXT] = &&JUMP_UNLESS_NOT_EQUAL_TEXT_LABEL;
+        labels[JUMP] = &&JUMP_LABEL;
+        labels[SWITCH_TYPE] = &&SWITCH_TYPE_LABEL;
+        labels[SWITCH_ELEMENT_TYPE] = &&SWITCH_ELEMENT_TYPE_LABEL;
+        labels[JUMP_UNLESS_COVERED] = &&JUMP_UNLESS_COVERED_LABEL;
+        labels[CALL] = &&CALL_LABEL;
+        labels[RETURN] = &&RETURN_LABEL;
+        labels[PRINT_LITERAL] = &&PRINT_LITERAL_LABEL;
+        labels[PRINT_VARIABLE] = &&PRINT_VARIABLE_LABEL;
+        labels[PRINT_ELEMENT] = &&PRINT_ELEMENT_LABEL;
+        labels[PRINT_ELEMENT_UNCHECKED] = &&PRINT_ELEMENT_UNCHECKED_LABEL;
+        labels[PRINT_ARRAY] = &&PRINT_ARRAY_LABEL;
+        labels[READ_VARIABLE] = &&READ_VARIABLE_LABEL;
+        labels[READ_ELEMENT] = &&READ_ELEMENT_LABEL;
+        labels[READ_ELEMENT_UNCHECKED] = &&READ_ELEMENT_UNCHECKED_LABEL;
+        labels[READ_ARRAY] = &&READ_ARRAY_LABEL;
+        labels[REDUCE_INTEGER] = &&REDUCE_INTEGER_LABEL;
+        labels[REDUCE_REAL] = &&REDUCE_REAL_LABEL;
+        labels[SWITCH_REDUCTION_TYPE] = &&SWITCH_REDUCTION_TYPE_LABEL;
+        labels[PRINT_REDUCTION] = &&PRINT_REDUCTION_LABEL;
+        labels[CHECK_VARIABLE] = &&CHECK_VARIABLE_LABEL;
+        labels[CHECK_ELEMENT] = &&CHECK_ELEMENT_LABEL;
+        labels[CHECK_OPERAND] = &&CHECK_OPERAND_LABEL;
+        labels[NEXT_LINE] = &&NEXT_LINE_LABEL;
+        labels[RAISE] = &&RAISE_LABEL;
+        labels[HALT] = &&HALT_LABEL;
+    }
+#endif
+
+    // No slot is added while the code runs
+    Slot *frame = slots.data();
+
+    // Where to continue after a subroutine returns
+    vector<int> returns;
+
+    int pc = 0;
+    while (true)
+    {
+        switch (code[pc])
+        {
+        // Three operand arithmetic, the target is written after both operands are read
+        INSTRUCTION(ADD_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 2]]), right = integerValue(frame[code[pc + 3]]);
+            integerTarget(frame[code[pc + 1]]) = left + right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(SUBTRACT_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 2]]), right = integerValue(frame[code[pc + 3]]);
+            integerTarget(frame[code[pc + 1]]) = left - right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(DIVIDE_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 2]]), right = integerValue(frame[code[pc + 3]]);
+            integerTarget(frame[code[pc + 1]]) = left / right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(MULTIPLY_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 2]]), right = integerValue(frame[code[pc + 3]]);
+            integerTarget(frame[code[pc + 1]]) = left * right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(MODULO_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 2]]), right = integerValue(frame[code[pc + 3]]);
+            integerTarget(frame[code[pc + 1]]) = left % right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(POWER_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 2]]), right = integerValue(frame[code[pc + 3]]);
+            integerTarget(frame[code[pc + 1]]) = power(left, right);
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(ADD_REAL)
+        {
+            double left = realValue(frame[code[pc + 2]]), right = realValue(frame[code[pc + 3]]);
+            realTarget(frame[code[pc + 1]]) = left + right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(SUBTRACT_REAL)
+        {
+            double left = realValue(frame[code[pc + 2]]), right = realValue(frame[code[pc + 3]]);
+            realTarget(frame[code[pc + 1]]) = left - right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(DIVIDE_REAL)
+        {
+            double left = realValue(frame[code[pc + 2]]), right = realValue(frame[code[pc + 3]]);
+            realTarget(frame[code[pc + 1]]) = left / right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(MULTIPLY_REAL)
+        {
+            double left = realValue(frame[code[pc + 2]]), right = realValue(frame[code[pc + 3]]);
+            realTarget(frame[code[pc + 1]]) = left * right;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(MODULO_REAL)
+        {
+            double left = realValue(frame[code[pc + 2]]), right = realValue(frame[code[pc + 3]]);
+            realTarget(frame[code[pc + 1]]) = fmod(left, right);
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(POWER_REAL)
+        {
+            double left = realValue(frame[code[pc + 2]]), right = realValue(frame[code[pc + 3]]);
+            realTarget(frame[code[pc + 1]]) = pow(left, right);
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(JOIN_TEXT)
+        {
+            string joined = textValue(frame[code[pc + 2]]) + textValue(frame[code[pc + 3]]);
+            textTarget(frame[code[pc + 1]]) = joined;
+            pc += 4;
+            DISPATCH();
+        }
+
+        // Copy a value into a variable, converting between integer and real
+        INSTRUCTION(MOVE_INTEGER)
+        {
+            int value = integerValue(frame[code[pc + 2]]);
+            integerTarget(frame[code[pc + 1]]) = value;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(MOVE_REAL)
+        {
+            double value = realValue(frame[code[pc + 2]]);
+            realTarget(frame[code[pc + 1]]) = value;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(MOVE_TEXT)
+        {
+            string value = textValue(frame[code[pc + 2]]);
+            textTarget(frame[code[pc + 1]]) = value;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(DECLARE_INTEGER)
+        {
+            int value = integerValue(frame[code[pc + 2]]);
+            frame[code[pc + 1]].types |= 1 << INTEGER;
+            frame[code[pc + 1]].integer = value;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(DECLARE_REAL)
+        {
+            double value = realValue(frame[code[pc + 2]]);
+            frame[code[pc + 1]].types |= 1 << REAL;
+            frame[code[pc + 1]].real = value;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(DECLARE_TEXT)
+        {
+            string value = textValue(frame[code[pc + 2]]);
+            frame[code[pc + 1]].types |= 1 << TEXT;
+            frame[code[pc + 1]].text = value;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(DECLARE_INTEGER_ARRAY)
+        {
+            Array &array = arrays[code[pc + 1]];
+            array.integers.assign(integerValue(frame[code[pc + 2]]), DEFAULT_INTEGER_VALUE);
+            array.types |= 1 << INTEGER_ARRAY;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(DECLARE_REAL_ARRAY)
+        {
+            Array &array = arrays[code[pc + 1]];
+            array.reals.assign(integerValue(frame[code[pc + 2]]), DEFAULT_REAL_VALUE);
+            array.types |= 1 << REAL_ARRAY;
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(DECLARE_TEXT_ARRAY)
+        {
+            Array &array = arrays[code[pc + 1]];
+            array.texts.assign(integerValue(frame[code[pc + 2]]), DEFAULT_TEXT_VALUE);
+            array.types |= 1 << TEXT_ARRAY;
+            pc += 3;
+            DISPATCH();
+        }
+
+        // Array elements, the operands are the target or value, the array and the index
+        INSTRUCTION(LOAD_INTEGER_ELEMENT)
+        {
+            Multitype element = getElement(code[pc + 2], integerValue(frame[code[pc + 3]]));
+            if (element.type == INTEGER)
+            {
+                frame[code[pc + 1]].integer = *element.integer;
+            }
+            else if (element.type == REAL)
+            {
+                frame[code[pc + 1]].integer = *element.real;
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(LOAD_REAL_ELEMENT)
+        {
+            Multitype element = getElement(code[pc + 2], integerValue(frame[code[pc + 3]]));
+            if (element.type == REAL)
+            {
+                frame[code[pc + 1]].real = *element.real;
+            }
+            else if (element.type == INTEGER)
+            {
+                frame[code[pc + 1]].real = *element.integer;
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(LOAD_TEXT_ELEMENT)
+        {
+            Multitype element = getElement(code[pc + 2], integerValue(frame[code[pc + 3]]));
+            if (element.type != TEXT)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            frame[code[pc + 1]].text = *element.text;
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(STORE_INTEGER_ELEMENT)
+        {
+            Multitype element = getElement(code[pc + 1], integerValue(frame[code[pc + 2]]));
+            if (element.type != INTEGER)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            *element.integer = integerValue(frame[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(STORE_REAL_ELEMENT)
+        {
+            Multitype element = getElement(code[pc + 1], integerValue(frame[code[pc + 2]]));
+            if (element.type != REAL)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            *element.real = realValue(frame[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+        }
+        INSTRUCTION(STORE_TEXT_ELEMENT)
+        {
+            Multitype element = getElement(code[pc + 1], integerValue(frame[code[pc + 2]]));
+            if (element.type != TEXT)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            *element.text = textValue(frame[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+        }
+
+        // Array elements a loop has proven to be in bounds, the operands are the same as above
+        INSTRUCTION(LOAD_INTEGER_ELEMENT_UNCHECKED)
+            frame[code[pc + 1]].integer = arrays[code[pc + 2]].integers[frame[code[pc + 3]].integer];
+            pc += 4;
+            DISPATCH();
+        INSTRUCTION(LOAD_REAL_ELEMENT_UNCHECKED)
+            frame[code[pc + 1]].real = arrays[code[pc + 2]].reals[frame[code[pc + 3]].integer];
+            pc += 4;
+            DISPATCH();
+        INSTRUCTION(LOAD_TEXT_ELEMENT_UNCHECKED)
+            frame[code[pc + 1]].text = arrays[code[pc + 2]].texts[frame[code[pc + 3]].integer];
+            pc += 4;
+            DISPATCH();
+        INSTRUCTION(STORE_INTEGER_ELEMENT_UNCHECKED)
+            arrays[code[pc + 1]].integers[frame[code[pc + 2]].integer] = integerValue(frame[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+        INSTRUCTION(STORE_REAL_ELEMENT_UNCHECKED)
+            arrays[code[pc + 1]].reals[frame[code[pc + 2]].integer] = realValue(frame[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+        INSTRUCTION(STORE_TEXT_ELEMENT_UNCHECKED)
+            arrays[code[pc + 1]].texts[frame[code[pc + 2]].integer] = textValue(frame[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+
+        // Compare two slots and jump to the third operand when the condition is false
+        INSTRUCTION(JUMP_UNLESS_LESS_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 1]]), right = integerValue(frame[code[pc + 2]]);
+            pc = left < right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_GREATER_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 1]]), right = integerValue(frame[code[pc + 2]]);
+            pc = left > right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_EQUAL_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 1]]), right = integerValue(frame[code[pc + 2]]);
+            pc = left == right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_NOT_EQUAL_INTEGER)
+        {
+            int left = integerValue(frame[code[pc + 1]]), right = integerValue(frame[code[pc + 2]]);
+            pc = left != right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_LESS_REAL)
+        {
+            double left = realValue(frame[code[pc + 1]]), right = realValue(frame[code[pc + 2]]);
+            pc = left < right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_GREATER_REAL)
+        {
+            double left = realValue(frame[code[pc + 1]]), right = realValue(frame[code[pc + 2]]);
+            pc = left > right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_EQUAL_REAL)
+        {
+            double left = realValue(frame[code[pc + 1]]), right = realValue(frame[code[pc + 2]]);
+            pc = left == right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_NOT_EQUAL_REAL)
+        {
+            double left = realValue(frame[code[pc + 1]]), right = realValue(frame[code[pc + 2]]);
+            pc = left != right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_LESS_TEXT)
+        {
+            string &left = textValue(frame[code[pc + 1]]), &right = textValue(frame[code[pc + 2]]);
+            pc = left < right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_GREATER_TEXT)
+        {
+            string &left = textValue(frame[code[pc + 1]]), &right = textValue(frame[code[pc + 2]]);
+            pc = left > right ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_EQUAL_TEXT)
+        {
+            string &left = textValue(frame[code[pc + 1]]), &right = textValue(frame[code[pc + 2]]);
+            pc = left.compare(right) == 0 ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_NOT_EQUAL_TEXT)
+        {
+            string &left = textValue(frame[code[pc + 1]]), &right = textValue(frame[code[pc + 2]]);
+            pc = left.compare(right) != 0 ? pc + 4 : code[pc + 3];
+            DISPATCH();
+        }
+
+        // Control flow
+        INSTRUCTION(JUMP)
+            pc = code[pc + 1];
+            DISPATCH();
+        INSTRUCTION(SWITCH_TYPE)
+        {
+            // The three addresses follow the slot in the order integer, text, real
+            int type = typeOf(frame[code[pc + 1]]);
+            if (type == -1)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc = code[pc + 2 + type];
+            DISPATCH();
+        }
+        INSTRUCTION(SWITCH_ELEMENT_TYPE)
+        {
+            Multitype element = getElement(code[pc + 1], integerValue(frame[code[pc + 2]]));
+            if (element.type == -1)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc = code[pc + 3 + element.type];
+            DISPATCH();
+        }
+        INSTRUCTION(JUMP_UNLESS_COVERED)
+        {
+            // The operands are the array, the slots of i and n and the address to jump to
+            // Falls through when i and n are integers, i is not negative and the array has n elements
+            Array &array = arrays[code[pc + 1]];
+            Slot &index = frame[code[pc + 2]];
+            Slot &bound = frame[code[pc + 3]];
+            int size = -1;
+            if (array.types & (1 << INTEGER_ARRAY))
+            {
+                size = array.integers.size();
+            }
+            else if (array.types & (1 << REAL_ARRAY))
+            {
+                size = array.reals.size();
+            }
+            else if (array.types & (1 << TEXT_ARRAY))
+            {
+                size = array.texts.size();
+            }
+            if (size != -1 && typeOf(index) == INTEGER && typeOf(bound) == INTEGER && index.integer >= 0 && bound.integer <= size)
+            {
+                pc += 5;
+            }
+            else
+            {
+                pc = code[pc + 4];
+            }
+            DISPATCH();
+        }
+        INSTRUCTION(CALL)
+            returns.push_back(pc + 2);
+            pc = code[pc + 1];
+            DISPATCH();
+        INSTRUCTION(RETURN)
+            // Returning from the main program ends the run
+            if (returns.empty())
+            {
+                return;
+            }
+            pc = returns.back();
+            returns.pop_back();
+            DISPATCH();
+
+        // Input and output
+        INSTRUCTION(PRINT_LITERAL)
+            outputText(textLiterals[code[pc + 1]]);
+            pc += 2;
+            DISPATCH();
+        INSTRUCTION(PRINT_VARIABLE)
+        {
+            Slot &slot = frame[code[pc + 1]];
+            int type = typeOf(slot);
+            if (type == INTEGER)
+            {
+                outputInteger(slot.integer);
+            }
+            else if (type == TEXT)
+            {
+                outputText(slot.text);
+            }
+            else if (type == REAL)
+            {
+                outputReal(slot.real);
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 2;
+            DISPATCH();
+        }
+        INSTRUCTION(PRINT_ELEMENT)
+        {
+            Multitype element = getElement(code[pc + 1], integerValue(frame[code[pc + 2]]));
+            if (element.type == INTEGER)
+            {
+                outputInteger(*element.integer);
+            }
+            else if (element.type == TEXT)
+            {
+                outputText(*element.text);
+            }
+            else if (element.type == REAL)
+            {
+                outputReal(*element.real);
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(PRINT_ELEMENT_UNCHECKED)
+        {
+            Multitype element = uncheckedElement(code[pc + 1], frame[code[pc + 2]].integer);
+            if (element.type == INTEGER)
+            {
+                outputInteger(*element.integer);
+            }
+            else if (element.type == TEXT)
+            {
+                outputText(*element.text);
+            }
+            else if (element.type == REAL)
+            {
+                outputReal(*element.real);
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(PRINT_ARRAY)
+        {
+            Slot &slot = frame[code[pc + 1]];
+            int type = typeOf(slot);
+            if (type == INTEGER)
+            {
+                outputInteger(slot.integer);
+            }
+            else if (type == TEXT)
+            {
+                outputText(slot.text);
+            }
+            else if (type == REAL)
+            {
+                outputReal(slot.real);
+            }
+            else if (!printArray(arrays[code[pc + 2]]))
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(READ_VARIABLE)
+        {
+            flushForInput();
+            Slot &slot = frame[code[pc + 1]];
+            int type = typeOf(slot);
+            if (type == INTEGER)
+            {
+                inputInteger(slot.integer);
+            }
+            else if (type == TEXT)
+            {
+                inputText(slot.text);
+            }
+            else if (type == REAL)
+            {
+                inputReal(slot.real);
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 2;
+            DISPATCH();
+        }
+        INSTRUCTION(READ_ELEMENT)
+        {
+            flushForInput();
+            Multitype element = getElement(code[pc + 1], integerValue(frame[code[pc + 2]]));
+            if (element.type == INTEGER)
+            {
+                inputInteger(*element.integer);
+            }
+            else if (element.type == TEXT)
+            {
+                inputText(*element.text);
+            }
+            else if (element.type == REAL)
+            {
+                inputReal(*element.real);
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(READ_ELEMENT_UNCHECKED)
+        {
+            flushForInput();
+            Multitype element = uncheckedElement(code[pc + 1], frame[code[pc + 2]].integer);
+            if (element.type == INTEGER)
+            {
+                inputInteger(*element.integer);
+            }
+            else if (element.type == TEXT)
+            {
+                inputText(*element.text);
+            }
+            else if (element.type == REAL)
+            {
+                inputReal(*element.real);
+            }
+            else
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(PRINT_REDUCTION)
+            printReduction(code[pc + 1], arrays[code[pc + 2]]);
+            pc += 3;
+            DISPATCH();
+        INSTRUCTION(READ_ARRAY)
+        {
+            flushForInput();
+            Slot &slot = frame[code[pc + 1]];
+            int type = typeOf(slot);
+            if (type == INTEGER)
+            {
+                inputInteger(slot.integer);
+            }
+            else if (type == TEXT)
+            {
+                inputText(slot.text);
+            }
+            else if (type == REAL)
+            {
+                inputReal(slot.real);
+            }
+            else if (!readArray(arrays[code[pc + 2]]))
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 3;
+            DISPATCH();
+        }
+
+        // Array reductions, the operands are the slot of the result, the kind of reduction and the array
+        INSTRUCTION(REDUCE_INTEGER)
+            frame[code[pc + 1]].integer = integerReduction(code[pc + 2], arrays[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+        INSTRUCTION(REDUCE_REAL)
+            frame[code[pc + 1]].real = realReduction(code[pc + 2], arrays[code[pc + 3]]);
+            pc += 4;
+            DISPATCH();
+        INSTRUCTION(SWITCH_REDUCTION_TYPE)
+        {
+            // The three addresses follow the array in the order integer, text, real
+            int type = reductionType(code[pc + 1], arrays[code[pc + 2]]);
+            if (type == -1)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc = code[pc + 3 + type];
+            DISPATCH();
+        }
+
+        // Bookkeeping
+        INSTRUCTION(CHECK_VARIABLE)
+            if (typeOf(frame[code[pc + 1]]) == -1)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 2;
+            DISPATCH();
+        INSTRUCTION(CHECK_ELEMENT)
+            if (getElement(code[pc + 1], integerValue(frame[code[pc + 2]])).type == -1)
+            {
+                printError(VARIABLE_NOT_FOUND);
+            }
+            pc += 3;
+            DISPATCH();
+        INSTRUCTION(CHECK_OPERAND)
+        {
+            // Read the slot the way the expression would have
+            Slot &slot = frame[code[pc + 1]];
+            if (code[pc + 2] == TEXT)
+            {
+                textValue(slot);
+            }
+            else
+            {
+                integerValue(slot);
+            }
+            pc += 3;
+            DISPATCH();
+        }
+        INSTRUCTION(NEXT_LINE)
+            currentLine++;
+            pc++;
+            DISPATCH();
+        INSTRUCTION(RAISE)
+            printError(code[pc + 1]);
+            DISPATCH();
+        INSTRUCTION(HALT)
+            endProgram();
+            DISPATCH();
+        }
+    }
+}
+
+#undef INSTRUCTION
+#undef DISPATCH
+
+// The type a slot is used as, integers come before texts and texts before reals like in getVariable
+int typeOf(Slot &slot)
+{
+    if (slot.types & (1 << INTEGER))
+    {
+        return INTEGER;
+    }
+    if (slot.types & (1 << TEXT))
+    {
+        return TEXT;
+    }
+    if (slot.types & (1 << REAL))
+    {
+        return REAL;
+    }
+    return -1;
+}
+
+// Read a slot the way solveForInteger reads a variable
+int integerValue(Slot &slot)
+{
+    int type = typeOf(slot);
+    if (type == INTEGER)
+    {
+        return slot.integer;
+    }
+    if (type == REAL)
+    {
+        return slot.real;
+    }
+    printError(VARIABLE_NOT_FOUND);
+    return 0;
+}
+
+double realValue(Slot &slot)
+{
+    int type = typeOf(slot);
+    if (type == REAL)
+    {
+        return slot.real;
+    }
+    if (type == INTEGER)
+    {
+        return slot.integer;
+    }
+    printError(VARIABLE_NOT_FOUND);
+    return 0.0;
+}
+
+string &textValue(Slot &slot)
+{
+    if (typeOf(slot) != TEXT)
+    {
+        printError(VARIABLE_NOT_FOUND);
+    }
+    return slot.text;
+}
+
+// The value of a slot which is about to be overwritten, the variable must already be of that type
+int &integerTarget(Slot &slot)
+{
+    if (typeOf(slot) != INTEGER)
+    {
+        printError(VARIABLE_NOT_FOUND);
+    }
+    return slot.integer;
+}
+
+double &realTarget(Slot &slot)
+{
+    if (typeOf(slot) != REAL)
+    {
+        printError(VARIABLE_NOT_FOUND);
+    }
+    return slot.real;
+}
+
+string &textTarget(Slot &slot)
+{
+    if (typeOf(slot) != TEXT)
+    {
+        printError(VARIABLE_NOT_FOUND);
+    }
+    return slot.text;
+}
+
+// Find an element of an array, the arrays of a name are tried in the order integer, real, text
+Multitype getElement(int array, int index)
+{
+    Multitype element;
+    element.type = -1;
+
+    Array &values = arrays[array];
+    if (values.types & (1 << INTEGER_ARRAY))
+    {
+        if (index < 0 || (size_t)index >= values.integers.size())
+        {
+            printError(INDEX_OUT_OF_BOUNDS);
+        }
+        element.integer = &values.integers[index];
+        element.type = INTEGER;
+    }
+    else if (values.types & (1 << REAL_ARRAY))
+    {
+        if (index < 0 || (size_t)index >= values.reals.size())
+        {
+            printError(INDEX_OUT_OF_BOUNDS);
+        }
+        element.real = &values.reals[index];
+        element.type = REAL;
+    }
+    else if (values.types & (1 << TEXT_ARRAY))
+    {
+        if (index < 0 || (size_t)index >= values.texts.size())
+        {
+            printError(INDEX_OUT_OF_BOUNDS);
+        }
+        element.text = &values.texts[index];
+        element.type = TEXT;
+    }
+    return element;
+}
+
+// Find an element like getElement does without checking the index
+Multitype uncheckedElement(int array, int index)
+{
+    Multitype element;
+    element.type = -1;
+
+    Array &values = arrays[array];
+    if (values.types & (1 << INTEGER_ARRAY))
+    {
+        element.integer = &values.integers[index];
+        element.type = INTEGER;
+    }
+    else if (values.types & (1 << REAL_ARRAY))
+    {
+        element.real = &values.reals[index];
+        element.type = REAL;
+    }
+    else if (values.types & (1 << TEXT_ARRAY))
+    {
+        element.text = &values.texts[index];
+        element.type = TEXT;
+    }
+    return element;
+}
+
+// Find an element the interpreter resolved, its index is read like solveForInteger reads a variable
+Multitype getElement(Element &element)
+{
+    return getElement(element.array, elementIndex(element));
+}
+
+int elementIndex(Element &element)
+{
+    if (element.error != -1)
+    {
+        printError(element.error);
+    }
+    Multitype index;
+    if (element.index != -1)
+    {
+        index = getVariable(slots[element.index]);
+    }
+    else
+    {
+        index = getElement(elements[element.element]);
+    }
+
+    if (index.type == INTEGER)
+    {
+        return *index.integer;
+    }
+    else if (index.type == REAL)
+    {
+        return *index.real;
+    }
+    printError(VARIABLE_NOT_FOUND);
+    return 0;
+}
+
+// Reduction functions
+
+// Join a reduction keyword and the array name after it into a single token
+void combineReductions(vector<Token> &tokens)
+{
+    size_t joined = 0;
+    for (size_t i = 0; i < tokens.size(); i++)
+    {
+        Token token = tokens[i];
+        if (token.type == KEYWORD_TOKEN && token.id >= SUM_OF && token.id <= COUNT_OF && i + 1 < tokens.size() && tokens[i + 1].type == IDENTIFIER_TOKEN && identifierNames[tokens[i + 1].id].find('-') == string::npos)
+        {
+            reductions.push_back({token.id, tokens[i + 1].id});
+            token.type = REDUCTION_TOKEN;
+            token.id = reductions.size() - 1;
+            i++;
+        }
+        tokens[joined++] = token;
+    }
+    tokens.resize(joined);
+}
+
+// The type of the elements of the array, -1 if it is not declared
+// The arrays of a name are tried in the order integer, real, text like getElement does
+int elementType(Array &array)
+{
+    if (array.types & (1 << INTEGER_ARRAY))
+    {
+        return INTEGER;
+    }
+    if (array.types & (1 << REAL_ARRAY))
+    {
+        return REAL;
+    }
+    if (array.types & (1 << TEXT_ARRAY))
+    {
+        return TEXT;
+    }
+    return -1;
+}
+
+// The type of the value the reduction gives, a count is always an integer
+int reductionType(int kind, Array &array)
+{
+    int type = elementType(array);
+    if (type != -1 && kind == COUNT_OF)
+    {
+        return INTEGER;
+    }
+    return type;
+}
+
+// A real result is cut to its whole part like a real operand of an integer expression
+int integerReduction(int kind, Array &array)
+{
+    int type = elementType(array);
+    if (type == -1)
+    {
+        printError(VARIABLE_NOT_FOUND);
+    }
+    if (kind == COUNT_OF)
+    {
+        return type == INTEGER ? array.integers.size() : type == REAL ? array.reals.size() : array.texts.size();
+    }
+    if (type == REAL)
+    {
+        return realReduction(kind, array);
+    }
+    if (type == TEXT)
+    {
+        printError(INVALID_DATA_TYPE);
+    }
+
+    if (!kernelsSelected)
+    {
+        selectKernels();
+    }
+    const int *values = array.integers.data();
+    size_t size = array.integers.size();
+    if (kind == SUM_OF)
+    {
+        return kernels.sumIntegers(values, size);
+    }
+    // An empty array has no smallest or largest element
+    if (size == 0)
+    {
+        printError(INDEX_OUT_OF_BOUNDS);
+    }
+    return kind == MINIMUM_OF ? kernels.minimumInteger(values, size) : kernels.maximumInteger(values, size);
+}
+
+double realReduction(int kind, Array &array)
+{
+    if (kind == COUNT_OF || elementType(array) != REAL)
+    {
+        return integerReduction(kind, array);
+    }
+
+    if (!kernelsSelected)
+    {
+        selectKernels();
+    }
+    const double *values = array.reals.data();
+    size_t size = array.reals.size();
+    if (kind == SUM_OF)
+    {
+        return kernels.sumReals(values, size);
+    }
+    if (size == 0)
+    {
+        printError(INDEX_OUT_OF_BOUNDS);
+    }
+    return kind == MINIMUM_OF ? kernels.minimumReal(values, size) : kernels.maximumReal(values, size);
+}
+
+void printReduction(int kind, Array &array)
+{
+    if (reductionType(kind, array) == INTEGER)
+    {
+        outputInteger(integerReduction(kind, array));
+    }
+    else
+    {
+        outputReal(realReduction(kind, array));
+    }
+}
+
+// Use the widest kernels the processor can run, checked once before the first reduction
+void selectKernels()
+{
+#ifdef SYMLS_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        kernels = {sumIntegersAvx2, minimumIntegerAvx2, maximumIntegerAvx2, sumRealsAvx2, minimumRealAvx2, maximumRealAvx2};
+    }
+    else if (__builtin_cpu_supports("sse4.1"))
+    {
+        kernels = {sumIntegersSse, minimumIntegerSse, maximumIntegerSse, sumRealsSse, minimumRealSse, maximumRealSse};
+    }
+#endif
+    kernelsSelected = true;
+}
+
+// The integer sum is added as unsigned, so that it wraps around the same way in every kernel
+int sumIntegersScalar(const int *values, size_t size)
+{
+    unsigned int sum = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        sum += values[i];
+    }
+    return sum;
+}
+
+int minimumIntegerScalar(const int *values, size_t size)
+{
+    int minimum = values[0];
+    for (size_t i = 1; i < size; i++)
+    {
+        minimum = values[i] < minimum ? values[i] : minimum;
+    }
+    return minimum;
+}
+
+int maximumIntegerScalar(const int *values, size_t size)
+{
+    int maximum = values[0];
+    for (size_t i = 1; i < size; i++)
+    {
+        maximum = values[i] > maximum ? values[i] : maximum;
+    }
+    return maximum;
+}
+
+// Every real kernel keeps eight lanes, lane j takes the elements at j, j + 8, j + 16 ...
+// and the lanes are combined in the same order, so a sum is rounded the same way whichever kernel runs
+double sumRealsScalar(const double *values, size_t size)
+{
+    double lanes[8] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        for (int lane = 0; lane < 8; lane++)
+        {
+            lanes[lane] += values[i + lane];
+        }
+    }
+    return combineLanes(SUM_OF, lanes, values, blocks, size);
+}
+
+// A comparison with not a number is false, the lanes keep what they had like the minpd and maxpd instructions do
+double minimumRealScalar(const double *values, size_t size)
+{
+    double lanes[8];
+    fill(lanes, lanes + 8, values[0]);
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        for (int lane = 0; lane < 8; lane++)
+        {
+            lanes[lane] = values[i + lane] < lanes[lane] ? values[i + lane] : lanes[lane];
+        }
+    }
+    return combineLanes(MINIMUM_OF, lanes, values, blocks, size);
+}
+
+double maximumRealScalar(const double *values, size_t size)
+{
+    double lanes[8];
+    fill(lanes, lanes + 8, values[0]);
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        for (int lane = 0; lane < 8; lane++)
+        {
+            lanes[lane] = values[i + lane] > lanes[lane] ? values[i + lane] : lanes[lane];
+        }
+    }
+    return combineLanes(MAXIMUM_OF, lanes, values, blocks, size);
+}
+
+// Fold the lanes from the first to the last, then the elements from start which did not fill a block of eight
+double combineLanes(int kind, const double lanes[8], const double *values, size_t start, size_t size)
+{
+    double result = lanes[0];
+    for (size_t i = 1; i < 8 + size - start; i++)
+    {
+        double value = i < 8 ? lanes[i] : values[start + i - 8];
+        if (kind == SUM_OF)
+        {
+            result += value;
+        }
+        else if (kind == MINIMUM_OF)
+        {
+            result = value < result ? value : result;
+        }
+        else
+        {
+            result = value > result ? value : result;
+        }
+    }
+    return result;
+}
+
+#ifdef SYMLS_X86_KERNELS
+// The vector kernels are compiled for their instruction set alone and only called after selectKernels checked it
+__attribute__((target("sse4.1"))) int sumIntegersSse(const int *values, size_t size)
+{
+    __m128i sum = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        sum = _mm_add_epi32(sum, _mm_loadu_si128((const __m128i *)(values + i)));
+    }
+    unsigned int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, sum);
+    unsigned int total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (; i < size; i++)
+    {
+        total += values[i];
+    }
+    return total;
+}
+
+__attribute__((target("sse4.1"))) int minimumIntegerSse(const int *values, size_t size)
+{
+    __m128i smallest = _mm_set1_epi32(values[0]);
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        smallest = _mm_min_epi32(smallest, _mm_loadu_si128((const __m128i *)(values + i)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, smallest);
+    int minimum = minimumIntegerScalar(lanes, 4);
+    for (; i < size; i++)
+    {
+        minimum = values[i] < minimum ? values[i] : minimum;
+    }
+    return minimum;
+}
+
+__attribute__((target("sse4.1"))) int maximumIntegerSse(const int *values, size_t size)
+{
+    __m128i largest = _mm_set1_epi32(values[0]);
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4)
+    {
+        largest = _mm_max_epi32(largest, _mm_loadu_si128((const __m128i *)(values + i)));
+    }
+    int lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, largest);
+    int maximum = maximumIntegerScalar(lanes, 4);
+    for (; i < size; i++)
+    {
+        maximum = values[i] > maximum ? values[i] : maximum;
+    }
+    return maximum;
+}
+
+__attribute__((target("sse4.1"))) double sumRealsSse(const double *values, size_t size)
+{
+    __m128d first = _mm_setzero_pd(), second = first, third = first, fourth = first;
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        first = _mm_add_pd(first, _mm_loadu_pd(values + i));
+        second = _mm_add_pd(second, _mm_loadu_pd(values + i + 2));
+        third = _mm_add_pd(third, _mm_loadu_pd(values + i + 4));
+        fourth = _mm_add_pd(fourth, _mm_loadu_pd(values + i + 6));
+    }
+    double lanes[8];
+    _mm_storeu_pd(lanes, first);
+    _mm_storeu_pd(lanes + 2, second);
+    _mm_storeu_pd(lanes + 4, third);
+    _mm_storeu_pd(lanes + 6, fourth);
+    return combineLanes(SUM_OF, lanes, values, blocks, size);
+}
+
+// minpd and maxpd give their second operand when either is not a number, the lanes are kept there
+__attribute__((target("sse4.1"))) double minimumRealSse(const double *values, size_t size)
+{
+    __m128d first = _mm_set1_pd(values[0]), second = first, third = first, fourth = first;
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        first = _mm_min_pd(_mm_loadu_pd(values + i), first);
+        second = _mm_min_pd(_mm_loadu_pd(values + i + 2), second);
+        third = _mm_min_pd(_mm_loadu_pd(values + i + 4), third);
+        fourth = _mm_min_pd(_mm_loadu_pd(values + i + 6), fourth);
+    }
+    double lanes[8];
+    _mm_storeu_pd(lanes, first);
+    _mm_storeu_pd(lanes + 2, second);
+    _mm_storeu_pd(lanes + 4, third);
+    _mm_storeu_pd(lanes + 6, fourth);
+    return combineLanes(MINIMUM_OF, lanes, values, blocks, size);
+}
+
+__attribute__((target("sse4.1"))) double maximumRealSse(const double *values, size_t size)
+{
+    __m128d first = _mm_set1_pd(values[0]), second = first, third = first, fourth = first;
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        first = _mm_max_pd(_mm_loadu_pd(values + i), first);
+        second = _mm_max_pd(_mm_loadu_pd(values + i + 2), second);
+        third = _mm_max_pd(_mm_loadu_pd(values + i + 4), third);
+        fourth = _mm_max_pd(_mm_loadu_pd(values + i + 6), fourth);
+    }
+    double lanes[8];
+    _mm_storeu_pd(lanes, first);
+    _mm_storeu_pd(lanes + 2, second);
+    _mm_storeu_pd(lanes + 4, third);
+    _mm_storeu_pd(lanes + 6, fourth);
+    return combineLanes(MAXIMUM_OF, lanes, values, blocks, size);
+}
+
+__attribute__((target("avx2"))) int sumIntegersAvx2(const int *values, size_t size)
+{
+    __m256i sum = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        sum = _mm256_add_epi32(sum, _mm256_loadu_si256((const __m256i *)(values + i)));
+    }
+    unsigned int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, sum);
+    unsigned int total = 0;
+    for (int lane = 0; lane < 8; lane++)
+    {
+        total += lanes[lane];
+    }
+    for (; i < size; i++)
+    {
+        total += values[i];
+    }
+    return total;
+}
+
+__attribute__((target("avx2"))) int minimumIntegerAvx2(const int *values, size_t size)
+{
+    __m256i smallest = _mm256_set1_epi32(values[0]);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        smallest = _mm256_min_epi32(smallest, _mm256_loadu_si256((const __m256i *)(values + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, smallest);
+    int minimum = minimumIntegerScalar(lanes, 8);
+    for (; i < size; i++)
+    {
+        minimum = values[i] < minimum ? values[i] : minimum;
+    }
+    return minimum;
+}
+
+__attribute__((target("avx2"))) int maximumIntegerAvx2(const int *values, size_t size)
+{
+    __m256i largest = _mm256_set1_epi32(values[0]);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        largest = _mm256_max_epi32(largest, _mm256_loadu_si256((const __m256i *)(values + i)));
+    }
+    int lanes[8];
+    _mm256_storeu_si256((__m256i *)lanes, largest);
+    int maximum = maximumIntegerScalar(lanes, 8);
+    for (; i < size; i++)
+    {
+        maximum = values[i] > maximum ? values[i] : maximum;
+    }
+    return maximum;
+}
+
+__attribute__((target("avx2"))) double sumRealsAvx2(const double *values, size_t size)
+{
+    __m256d low = _mm256_setzero_pd(), high = low;
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        low = _mm256_add_pd(low, _mm256_loadu_pd(values + i));
+        high = _mm256_add_pd(high, _mm256_loadu_pd(values + i + 4));
+    }
+    double lanes[8];
+    _mm256_storeu_pd(lanes, low);
+    _mm256_storeu_pd(lanes + 4, high);
+    return combineLanes(SUM_OF, lanes, values, blocks, size);
+}
+
+__attribute__((target("avx2"))) double minimumRealAvx2(const double *values, size_t size)
+{
+    __m256d low = _mm256_set1_pd(values[0]), high = low;
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        low = _mm256_min_pd(_mm256_loadu_pd(values + i), low);
+        high = _mm256_min_pd(_mm256_loadu_pd(values + i + 4), high);
+    }
+    double lanes[8];
+    _mm256_storeu_pd(lanes, low);
+    _mm256_storeu_pd(lanes + 4, high);
+    return combineLanes(MINIMUM_OF, lanes, values, blocks, size);
+}
+
+__attribute__((target("avx2"))) double maximumRealAvx2(const double *values, size_t size)
+{
+    __m256d low = _mm256_set1_pd(values[0]), high = low;
+    size_t blocks = size - size % 8;
+    for (size_t i = 0; i < blocks; i += 8)
+    {
+        low = _mm256_max_pd(_mm256_loadu_pd(values + i), low);
+        high = _mm256_max_pd(_mm256_loadu_pd(values + i + 4), high);
+    }
+    double lanes[8];
+    _mm256_storeu_pd(lanes, low);
+    _mm256_storeu_pd(lanes + 4, high);
+    return combineLanes(MAXIMUM_OF, lanes, values, blocks, size);
+}
+#endif
+
+// Utility Functions
+
+// Integer power by squaring, the result wraps around like repeated multiplication would
+// A negative exponent gives the whole part of 1 / number^-exponent, which is 0 unless the number is 1 or -1
+int power(int number, int exponent)
+{
+    if (number == 1)
+    {
+        return 1;
+    }
+    if (number == -1)
+    {
+        return exponent % 2 == 0 ? 1 : -1;
+    }
+    if (exponent < 0 || number == 0)
+    {
+        return exponent == 0 ? 1 : 0;
+    }
+    if (number == 2)
+    {
+        return exponent < 32 ? (int)(1u << exponent) : 0;
+    }
+
+    // Unsigned multiplication wraps without undefined behavior
+    unsigned int result = 1, base = number;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+        {
+            result *= base;
+        }
+        base *= base;
+        exponent >>= 1;
+    }
+    return (int)result;
+}
+
+// Move the cursor to the first character
+void trim(string &str, int &position)
+{
+    while (str[position] == ' ' && str[position] != '\0')
+    {
+        position++;
+    }
+}
+
+// Read the expression until the next space
+void readUntilNextSpace(string &expr, int &position, string &temp)
+{
+    char checkFor = ' ';
+    if (expr[position] == '"')
+    {
+        checkFor = '"';
+        temp += expr[position];
+        position++;
+    }
+    while (expr[position] != checkFor && expr[position] != '\0')
+    {
+        temp += expr[position];
+        position++;
+    }
+    if (checkFor == '"' && expr[position] != '\0')
+    {
+        temp += expr[position];
+        position++;
+    }
+}
+
+// Read the word at the cursor from the bytes of a line, a string literal is read up to its closing quote
+void readWord(const char *&cursor, const char *end, string &word)
+{
+    const char *start = cursor;
+    if (*cursor == '"')
+    {
+        cursor++;
+        while (cursor < end && *cursor != '"' && *cursor != '\0')
+        {
+            cursor++;
+        }
+        if (cursor < end && *cursor == '"')
+        {
+            cursor++;
+        }
+    }
+    else
+    {
+        while (cursor < end && *cursor != ' ' && *cursor != '\0')
+        {
+            cursor++;
+        }
+    }
+    word.assign(start, cursor);
+}
+
+// Check if the token is a specific keyword
+int isKeyword(Token &token, int keyword)
+{
+    return token.type == KEYWORD_TOKEN && token.id == keyword;
+}
+
+// Check if the token ends a statement
+int endsStatement(Token &token)
+{
+    return isKeyword(token, AND) || closesBlock(token);
+}
+
+// Check if the token closes the block of an if or a while
+int closesBlock(Token &token)
+{
+    return isKeyword(token, ELSE) || isKeyword(token, STOP) || isKeyword(token, TILLHERE);
+}
+
+// Check if the string is a number
+int isNumber(string &str)
+{
+    int dotCount = 0;
+    for (size_t i = 0; i < str.length(); i++)
+    {
+        if (str[i] < '0' || str[i] > '9')
+        {
+            if (str[i] == '-' && i == 0)
+            {
+                continue;
+            }
+            if (str[i] == '.' && dotCount == 0)
+            {
+                dotCount++;
+                continue;
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+// Check if the string is a string literal (Enclosed in double quotes)
+int isString(string &str)
+{
+    if (str[0] == '"' && str[str.length() - 1] == '"')
+    {
+        return true;
+    }
+    return false;
+}
+
+// Check if the string is a real number
+int isReal(string &str)
+{
+    int dotCount = 0;
+    for (size_t i = 0; i < str.length(); i++)
+    {
+        if (str[i] < '0' || str[i] > '9')
+        {
+            if (str[i] == '-' && i == 0)
+            {
+                continue;
+            }
+            if (str[i] == '.' && dotCount == 0)
+            {
+                dotCount++;
+                continue;
+            }
+            return false;
+        }
+    }
+    if (dotCount == 1)
+    {
+        return true;
+    }
+    return false;
+}
+
+// Validate the name of the variable
+int validateName(string name)
+{
+    // Name cannot be empty
+    if (name[0] == '\n')
+        return false;
+
+    // Name cannot start with a number
+    if (name[0] >= '0' && name[0] <= '0')
+        return false;
+
+    // Name can only contain alphabets and numbers
+    for (size_t i = 0; i < name.length(); i++)
+    {
+        if (name[i] >= '0' && name[i] <= '9')
+            continue;
+        if (name[i] >= 'a' && name[i] <= 'z')
+            continue;
+        if (name[i] >= 'A' && name[i] <= 'Z')
+            continue;
+        return false;
+    }
+
+    // Name cannot be a reserved keyword
+    for (auto reserved : reservedWords)
+    {
+        if (name.compare(reserved) == 0)
+            return false;
+    }
+    return true;
+}
+
+Multitype getVariable(Token &token)
+{
+    // Only identifiers can name a variable
+    if (token.type == IDENTIFIER_TOKEN)
+    {
+        // Variables and array elements were resolved before running
+        if (identifierSlots[token.id] != -1)
+        {
+            return getVariable(slots[identifierSlots[token.id]]);
+        }
+        if (identifierElements[token.id] != -1)
+        {
+            return getElement(elements[identifierElements[token.id]]);
+        }
+    }
+    Multitype variable;
+    variable.type = -1;
+    return variable;
+}
+
+Multitype getVariable(Slot &slot)
+{
+    Multitype variable;
+    variable.integer = &slot.integer;
+    variable.real = &slot.real;
+    variable.text = &slot.text;
+    variable.type = typeOf(slot);
+    return variable;
+}
+
+// Cache functions
+
+// The cache of a program is kept next to it, or in the cache directory, with the extension .symlsc
+string cachePath(string fileName)
+{
+    string path = fileName;
+    if (path.size() >= 6 && path.compare(path.size() - 6, 6, ".symls") == 0)
+    {
+        path.append("c");
+    }
+    else
+    {
+        path.append(".symlsc");
+    }
+    if (!cacheDirectory.empty())
+    {
+        size_t slash = path.find_last_of("/\\");
+        path = cacheDirectory + "/" + (slash == string::npos ? path : path.substr(slash + 1));
+    }
+    return path;
+}
+
+// Hash of everything the compiled code depends on, the bytes of the program and of the configuration file,
+// the options which change the compiled code and the instruction set
+unsigned long long cacheKey(string fileName)
+{
+    unsigned long long hash = 14695981039346656037ull;
+    SourceFile file;
+    if (openSource(fileName, file))
+    {
+        hash = hashBytes(file.bytes, file.size, hash);
+        closeSource(file);
+    }
+    if (openSource(configFileName, file))
+    {
+        hash = hashBytes(file.bytes, file.size, hash);
+        closeSource(file);
+    }
+    int options[] = {inlining, HALT};
+    return hashBytes((const char *)options, sizeof(options), hash);
+}
+
+// 64 bit FNV-1a, hashes the bytes after the ones already hashed into hash
+unsigned long long hashBytes(const char *bytes, size_t size, unsigned long long hash)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ (unsigned char)bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+// Map the cache and restore the tables the code runs with, return the code or nullptr if the cache can not be used
+// The code is run from the mapping, which stays open until the program ends
+const int *loadCache(string path, unsigned long long key, SourceFile &cache)
+{
+    if (!openSource(path, cache))
+    {
+        return nullptr;
+    }
+    CacheHeader header;
+    if (cache.size < sizeof(header))
+    {
+        closeSource(cache);
+        return nullptr;
+    }
+    memcpy(&header, cache.bytes, sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != CACHE_VERSION || header.integerSize != sizeof(int) || header.key != key || header.codeOffset % 8 != 0 || header.codeOffset > cache.size || header.codeSize > (cache.size - header.codeOffset) / sizeof(int) || header.tablesOffset > cache.size || header.tablesSize > cache.size - header.tablesOffset)
+    {
+        closeSource(cache);
+        return nullptr;
+    }
+
+    // The tables are read into new containers, which replace the empty ones only when all of them are read
+    const char *cursor = cache.bytes + header.tablesOffset, *end = cursor + header.tablesSize;
+    int valid = true;
+    string inputFile = readText(cursor, end, valid);
+    string outputFile = readText(cursor, end, valid);
+    string errorFile = readText(cursor, end, valid);
+    int integerValue = readInteger(cursor, end, valid);
+    double realValue = readReal(cursor, end, valid);
+    string textValue = readText(cursor, end, valid);
+    string separator = readText(cursor, end, valid);
+    map<int, string> messages;
+    for (long long i = readInteger(cursor, end, valid); valid && i > 0; i--)
+    {
+        int error = readInteger(cursor, end, valid);
+        messages[error] = readText(cursor, end, valid);
+    }
+    vector<string> literals;
+    for (long long i = readInteger(cursor, end, valid); valid && i > 0; i--)
+    {
+        literals.push_back(readText(cursor, end, valid));
+    }
+    vector<Slot> values;
+    for (long long i = readInteger(cursor, end, valid); valid && i > 0; i--)
+    {
+        Slot slot;
+        slot.types = readInteger(cursor, end, valid);
+        slot.integer = readInteger(cursor, end, valid);
+        slot.real = readReal(cursor, end, valid);
+        slot.text = readText(cursor, end, valid);
+        values.push_back(slot);
+    }
+    long long arrayCount = readInteger(cursor, end, valid);
+    const int *code = (const int *)(cache.bytes + header.codeOffset);
+    if (!valid || arrayCount < 0 || (uint64_t)arrayCount > header.tablesSize || !checkCode(code, header.codeSize, values.size(), arrayCount, literals.size(), messages))
+    {
+        closeSource(cache);
+        return nullptr;
+    }
+
+    inputFileName = inputFile;
+    outputFileName = outputFile;
+    errorFileName = errorFile;
+    DEFAULT_INTEGER_VALUE = integerValue;
+    DEFAULT_REAL_VALUE = realValue;
+    DEFAULT_TEXT_VALUE = textValue;
+    ARRAY_SEPARATOR = separator;
+    errorMassage = messages;
+    textLiterals.swap(literals);
+    slots.swap(values);
+    arrays.assign(arrayCount, Array());
+    for (auto &array : arrays)
+    {
+        array.types = 0;
+    }
+    return code;
+}
+
+// The operands of an instruction, a letter for each of them
+// s is a slot, a an array, l a text literal, j an address, r a reduction, t a data type and e an error
+const char *operandsOf(int instruction)
+{
+    switch (instruction)
+    {
+    case ADD_INTEGER:
+    case SUBTRACT_INTEGER:
+    case DIVIDE_INTEGER:
+    case MULTIPLY_INTEGER:
+    case MODULO_INTEGER:
+    case POWER_INTEGER:
+    case ADD_REAL:
+    case SUBTRACT_REAL:
+    case DIVIDE_REAL:
+    case MULTIPLY_REAL:
+    case MODULO_REAL:
+    case POWER_REAL:
+    case JOIN_TEXT:
+        return "sss";
+    case MOVE_INTEGER:
+    case MOVE_REAL:
+    case MOVE_TEXT:
+    case DECLARE_INTEGER:
+    case DECLARE_REAL:
+    case DECLARE_TEXT:
+        return "ss";
+    case DECLARE_INTEGER_ARRAY:
+    case DECLARE_REAL_ARRAY:
+    case DECLARE_TEXT_ARRAY:
+    case PRINT_ELEMENT:
+    case PRINT_ELEMENT_UNCHECKED:
+    case READ_ELEMENT:
+    case READ_ELEMENT_UNCHECKED:
+    case CHECK_ELEMENT:
+        return "as";
+    case LOAD_INTEGER_ELEMENT:
+    case LOAD_REAL_ELEMENT:
+    case LOAD_TEXT_ELEMENT:
+    case LOAD_INTEGER_ELEMENT_UNCHECKED:
+    case LOAD_REAL_ELEMENT_UNCHECKED:
+    case LOAD_TEXT_ELEMENT_UNCHECKED:
+        return "sas";
+    case STORE_INTEGER_ELEMENT:
+    case STORE_REAL_ELEMENT:
+    case STORE_TEXT_ELEMENT:
+    case STORE_INTEGER_ELEMENT_UNCHECKED:
+    case STORE_REAL_ELEMENT_UNCHECKED:
+    case STORE_TEXT_ELEMENT_UNCHECKED:
+        return "ass";
+    case JUMP_UNLESS_LESS_INTEGER:
+    case JUMP_UNLESS_GREATER_INTEGER:
+    case JUMP_UNLESS_EQUAL_INTEGER:
+    case JUMP_UNLESS_NOT_EQUAL_INTEGER:
+    case JUMP_UNLESS_LESS_REAL:
+    case JUMP_UNLESS_GREATER_REAL:
+    case JUMP_UNLESS_EQUAL_REAL:
+    case JUMP_UNLESS_NOT_EQUAL_REAL:
+    case JUMP_UNLESS_LESS_TEXT:
+    case JUMP_UNLESS_GREATER_TEXT:
+    case JUMP_UNLESS_EQUAL_TEXT:
+    case JUMP_UNLESS_NOT_EQUAL_TEXT:
+        return "ssj";
+    case JUMP:
+    case CALL:
+        return "j";
+    case SWITCH_TYPE:
+        return "sjjj";
+    case SWITCH_ELEMENT_TYPE:
+        return "asjjj";
+    case JUMP_UNLESS_COVERED:
+        return "assj";
+    case PRINT_LITERAL:
+        return "l";
+    case PRINT_VARIABLE:
+    case READ_VARIABLE:
+    case CHECK_VARIABLE:
+        return "s";
+    case PRINT_ARRAY:
+    case READ_ARRAY:
+        return "sa";
+    case REDUCE_INTEGER:
+    case REDUCE_REAL:
+        return "sra";
+    case SWITCH_REDUCTION_TYPE:
+        return "rajjj";
+    case PRINT_REDUCTION:
+        return "ra";
+    case CHECK_OPERAND:
+        return "st";
+    case RAISE:
+        return "e";
+    case RETURN:
+    case NEXT_LINE:
+    case HALT:
+        return "";
+    }
+    return nullptr;
+}
+
+// Check that the code of a cache only uses the tables restored with it, the virtual machine checks none of it
+// Every operand has to fit its table, every address has to start an instruction and the last one must not fall through
+int checkCode(const int *code, size_t size, size_t slotCount, size_t arrayCount, size_t literalCount, map<int, string> &messages)
+{
+    vector<char> starts(size, false);
+    size_t pc = 0;
+    int last = -1;
+    while (pc < size)
+    {
+        starts[pc] = true;
+        last = code[pc];
+        const char *operands = operandsOf(code[pc]);
+        if (operands == nullptr || strlen(operands) >= size - pc)
+        {
+            return false;
+        }
+        pc += 1 + strlen(operands);
+    }
+    if (last != HALT && last != RETURN && last != JUMP)
+    {
+        return false;
+    }
+
+    for (pc = 0; pc < size; pc += 1 + strlen(operandsOf(code[pc])))
+    {
+        const char *operands = operandsOf(code[pc]);
+        for (int i = 0; operands[i] != '\0'; i++)
+        {
+            int operand = code[pc + 1 + i];
+            int valid = operand >= 0;
+            switch (operands[i])
+            {
+            case 's':
+                valid = valid && (size_t)operand < slotCount;
+                break;
+            case 'a':
+                valid = valid && (size_t)operand < arrayCount;
+                break;
+            case 'l':
+                valid = valid && (size_t)operand < literalCount;
+                break;
+            case 'j':
+                valid = valid && (size_t)operand < size && starts[operand];
+                break;
+            case 'r':
+                valid = operand == SUM_OF || operand == MINIMUM_OF || operand == MAXIMUM_OF || operand == COUNT_OF;
+                break;
+            case 't':
+                valid = true;
+                break;
+            case 'e':
+                valid = messages.count(operand) == 1;
+                break;
+            }
+            if (!valid)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Write the compiled code with the tables it runs with, the slots are saved before the code has changed them
+void saveCache(string path, unsigned long long key, Bytecode &bytecode)
+{
+    string tables;
+    writeText(tables, inputFileName);
+    writeText(tables, outputFileName);
+    writeText(tables, errorFileName);
+    writeInteger(tables, DEFAULT_INTEGER_VALUE);
+    writeReal(tables, DEFAULT_REAL_VALUE);
+    writeText(tables, DEFAULT_TEXT_VALUE);
+    writeText(tables, ARRAY_SEPARATOR);
+    writeInteger(tables, errorMassage.size());
+    for (auto &message : errorMassage)
+    {
+        writeInteger(tables, message.first);
+        writeText(tables, message.second);
+    }
+    writeInteger(tables, textLiterals.size());
+    for (auto &literal : textLiterals)
+    {
+        writeText(tables, literal);
+    }
+    writeInteger(tables, slots.size());
+    for (auto &slot : slots)
+    {
+        writeInteger(tables, slot.types);
+        writeInteger(tables, slot.integer);
+        writeReal(tables, slot.real);
+        writeText(tables, slot.text);
+    }
+    writeInteger(tables, arrays.size());
+
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.version = CACHE_VERSION;
+    header.integerSize = sizeof(int);
+    header.key = key;
+    header.codeOffset = sizeof(header);
+    header.codeSize = bytecode.code.size();
+    header.tablesOffset = (header.codeOffset + header.codeSize * sizeof(int) + 7) / 8 * 8;
+    header.tablesSize = tables.size();
+
+    string bytes((const char *)&header, sizeof(header));
+    bytes.append((const char *)bytecode.code.data(), header.codeSize * sizeof(int));
+    bytes.resize(header.tablesOffset, '\0');
+    bytes.append(tables);
+    replaceFile(path, bytes);
+}
+
+// Write the file to a temporary file and rename it, so that another run never maps half of it
+// Every run writes its own temporary file, so runs replacing the same file at once never write into each other's
+// A file which can not be written is skipped, the program still runs
+void replaceFile(string path, const string &bytes)
+{
+#ifdef SYMLS_POSIX_IO
+    string temporary = path + ".XXXXXX";
+    int descriptor = mkstemp(&temporary[0]);
+    if (descriptor == -1)
+    {
+        return;
+    }
+
+    // mkstemp creates the file readable only by its owner
+    fchmod(descriptor, 0644);
+    int written = true;
+    const char *cursor = bytes.data();
+    size_t left = bytes.size();
+    while (left > 0)
+    {
+        ssize_t count = write(descriptor, cursor, left);
+        if (count < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (count <= 0)
+        {
+            written = false;
+            break;
+        }
+        cursor += count;
+        left -= count;
+    }
+    if (close(descriptor) != 0 || !written || rename(temporary.c_str(), path.c_str()) != 0)
+    {
+        unlink(temporary.c_str());
+    }
+#else
+    random_device random;
+    string temporary = path + "." + to_string(random()) + to_string(random()) + ".tmp";
+    ofstream file(temporary, ios::binary);
+    if (!file.is_open())
+    {
+        return;
+    }
+    file.write(bytes.data(), bytes.size());
+    file.close();
+
+    // filesystem::rename replaces an existing file in one step on every system
+    error_code error;
+    if (file.fail())
+    {
+        filesystem::remove(temporary, error);
+        return;
+    }
+    filesystem::rename(temporary, path, error);
+    if (error)
+    {
+        filesystem::remove(temporary, error);
+    }
+#endif
+}
+
+// The tables are stored as 8 byte integers and reals, a text is its length followed by its bytes
+void writeInteger(string &tables, long long value)
+{
+    tables.append((const char *)&value, sizeof(value));
+}
+
+void writeReal(string &tables, double value)
+{
+    tables.append((const char *)&value, sizeof(value));
+}
+
+void writeText(string &tables, const string &text)
+{
+    writeInteger(tables, text.size());
+    tables.append(text);
+}
+
+// The readers clear valid instead of reading past the end of the tables
+long long readInteger(const char *&cursor, const char *end, int &valid)
+{
+    long long value = 0;
+    if (!valid || end - cursor < (long)sizeof(value))
+    {
+        valid = false;
+        return 0;
+    }
+    memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    return value;
+}
+
+double readReal(const char *&cursor, const char *end, int &valid)
+{
+    double value = 0.0;
+    if (!valid || end - cursor < (long)sizeof(value))
+    {
+        valid = false;
+        return 0.0;
+    }
+    memcpy(&value, cursor, sizeof(value));
+    cursor += sizeof(value);
+    return value;
+}
+
+string readText(const char *&cursor, const char *end, int &valid)
+{
+    long long size = readInteger(cursor, end, valid);
+    if (!valid || size < 0 || size > end - cursor)
+    {
+        valid = false;
+        return "";
+    }
+    string text(cursor, size);
+    cursor += size;
+    return text;
+}
+
+// Preprocessor functions
+
+// Map the program file into memory, where mapping is not available it is read into the text of the file
+// Return false if the file can not be opened
+int openSource(string fileName, SourceFile &file)
+{
+    file.bytes = nullptr;
+    file.size = 0;
+    file.mapped = false;
+
+#ifdef SYMLS_MMAP
+    int descriptor = open(fileName.c_str(), O_RDONLY);
+    if (descriptor == -1)
+    {
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0)
+    {
+        void *bytes = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (bytes != MAP_FAILED)
+        {
+            // The file is read once from the start to the end
+            madvise(bytes, status.st_size, MADV_SEQUENTIAL);
+            file.bytes = (const char *)bytes;
+            file.size = status.st_size;
+            file.mapped = true;
+        }
+    }
+    close(descriptor);
+    if (file.mapped)
+    {
+        return true;
+    }
+#endif
+
+    // Empty files and files which can not be mapped
+    ifstream program(fileName, ios::binary);
+    if (program.fail())
+    {
+        return false;
+    }
+    file.text.assign(istreambuf_iterator<char>(program), istreambuf_iterator<char>());
+    file.bytes = file.text.data();
+    file.size = file.text.size();
+    return true;
+}
+
+void closeSource(SourceFile &file)
+{
+#ifdef SYMLS_MMAP
+    if (file.mapped)
+    {
+        munmap((void *)file.bytes, file.size);
+    }
+#endif
+    file.bytes = nullptr;
+    file.size = 0;
+    file.mapped = false;
+    file.text.clear();
+}
+
+// Tokenize the program straight from the bytes of the file, every SourceLine is one line of the preprocessed program
+// Lines ending with and, then, else or do are chained with the next line, empty lines and comments are skipped
+// Return false if the file can not be opened
+int preprocess(string fileName, vector<SourceLine> &lines)
+{
+    SourceFile file;
+    if (!openSource(fileName, file))
+    {
+        return false;
+    }
+
+    // The preprocessed program is only written to a file to debug the preprocessor
+    ofstream processedProgram;
+    if (dumpPreprocessed)
+    {
+        processedProgram.open(preprocessedFileName);
+    }
+
+    const string &leave = keywordsToString.at(LEAVE), &subroutineKeyword = keywordsToString.at(SUBROUTINE), &endKeyword = keywordsToString.at(END);
+    const string &andKeyword = keywordsToString.at(AND), &thenKeyword = keywordsToString.at(THEN), &elseKeyword = keywordsToString.at(ELSE), &doKeyword = keywordsToString.at(DO);
+    const char *cursor = file.bytes, *end = file.bytes + file.size;
+    int chained = false, words = 0;
+    string word, firstWord;
+    while (cursor < end)
+    {
+        const char *lineEnd = (const char *)memchr(cursor, '\n', end - cursor);
+        if (lineEnd == nullptr)
+        {
+            lineEnd = end;
+        }
+        const char *next = lineEnd == end ? end : lineEnd + 1;
+
+        // Only spaces separate the words
+        while (cursor < lineEnd && *cursor == ' ')
+        {
+            cursor++;
+        }
+
+        // Skip empty lines and comments
+        if (cursor == lineEnd || *cursor == '\0' || (lineEnd - cursor >= (long)leave.size() && memcmp(cursor, leave.data(), leave.size()) == 0))
+        {
+            cursor = next;
+            continue;
+        }
+
+        if (!chained)
+        {
+            lines.push_back(SourceLine());
+            lines.back().subroutine = -1;
+            words = 0;
+        }
+        SourceLine &line = lines.back();
+        const char *lineStart = cursor;
+
+        // Read the words of the line
+        while (cursor < lineEnd && *cursor != '\0')
+        {
+            const char *wordStart = cursor;
+            word.clear();
+            readWord(cursor, lineEnd, word);
+            line.tokens.push_back(classifyWord(word));
+
+            // A line starting with the keyword SUBROUTINE defines the subroutine named by its second word
+            if (words == 0)
+            {
+                firstWord = word;
+                if (word.compare(subroutineKeyword) == 0)
+                {
+                    string subroutineName = "";
+                    line.subroutine = internIdentifier(subroutineName);
+                }
+            }
+            else if (words == 1 && line.subroutine != -1)
+            {
+                line.subroutine = internIdentifier(word);
+            }
+
+            if (dumpPreprocessed)
+            {
+                processedProgram << (wordStart == lineStart ? "" : " ") << word;
+            }
+            words++;
+
+            while (cursor < lineEnd && *cursor == ' ')
+            {
+                cursor++;
+            }
+        }
+
+        // The line which is only the keyword END ends a subroutine
+        line.end = words == 1 && firstWord.compare(endKeyword) == 0;
+
+        // Read the last word of the line
+        const char *lastEnd = lineEnd;
+        while (lastEnd > lineStart && lastEnd[-1] == ' ')
+        {
+            lastEnd--;
+        }
+        const char *lastStart = lastEnd;
+        while (lastStart > lineStart && lastStart[-1] != ' ')
+        {
+            lastStart--;
+        }
+        string lastWord(lastStart, lastEnd);
+
+        // If the last word is not AND, THEN, ELSE, DO then chain the next line with the current line
+        chained = lastWord.compare(andKeyword) == 0 || lastWord.compare(thenKeyword) == 0 || lastWord.compare(elseKeyword) == 0 || lastWord.compare(doKeyword) == 0;
+        if (dumpPreprocessed)
+        {
+            processedProgram << (chained ? " " : "\n");
+        }
+        cursor = next;
+    }
+    closeSource(file);
+
+    // Preload the subroutines from the preprocessed lines
+    for (size_t i = 0; i < lines.size(); i++)
+    {
+        if (lines[i].subroutine == -1)
+        {
+            continue;
+        }
+
+        // Store the parsed code of the subroutine, a subroutine defined again replaces the earlier one
+        int identifier = lines[i].subroutine;
+        if (identifierSubroutines[identifier] == -1)
+        {
+            identifierSubroutines[identifier] = subroutines.size();
+            subroutines.push_back(Subroutine());
+        }
+        Subroutine &subroutine = subroutines[identifierSubroutines[identifier]];
+        subroutine.lines.clear();
+        for (i++; i < lines.size(); i++)
+        {
+            if (lines[i].end)
+            {
+                break;
+            }
+            subroutine.lines.push_back(vector<Statement>());
+            parse(lines[i].tokens, subroutine.lines.back());
+        }
+    }
+    return true;
+}
+
+// Redirect the standard streams to the files of the configuration
+void openStreams()
+{
+    if (inputFileName.compare("stdin") != 0)
+    {
+        freopen(inputFileName.c_str(), "r", stdin);
+    }
+    if (outputFileName.compare("stdout") != 0)
+    {
+        freopen(outputFileName.c_str(), "w", stdout);
+    }
+    if (errorFileName.compare("stderr") != 0)
+    {
+        freopen(errorFileName.c_str(), "w", stderr);
+    }
+#ifdef SYMLS_POSIX_IO
+    interactiveInput = isatty(fileno(stdin));
+#endif
+}
+
+// Load the configuration from its snapshot, or from symlsConfig.json when the snapshot is out of date
+// Without a configuration file the built in defaults are kept
+void configure()
+{
+    error_code error;
+    unsigned long long size = filesystem::file_size(configFileName, error);
+    if (error)
+    {
+        openStreams();
+        return;
+    }
+    long long modified = filesystem::last_write_time(configFileName, error).time_since_epoch().count();
+
+    vector<string> values;
+    if (error || !loadSnapshot(modified, size, nullptr, values))
+    {
+        // Open the configuration file
+        ifstream configFile(configFileName, ios::binary);
+        if (configFile.fail())
+        {
+            openStreams();
+            return;
+        }
+
+        // Store the data of the configuration file in a string
+        string configurations((istreambuf_iterator<char>(configFile)), istreambuf_iterator<char>());
+        configFile.close();
+
+        // The snapshot is still up to date if only the modification time has changed
+        unsigned long long hash = hashBytes(configurations.data(), configurations.size(), 14695981039346656037ull);
+        if (!loadSnapshot(modified, size, &hash, values))
+        {
+            readConfiguration(configurations, values);
+        }
+        saveSnapshot(modified, size, hash, values);
+    }
+    applyConfiguration(values);
+}
+
+// Configuration snapshot functions
+
+// Read the values from the snapshot if it matches the modification time and size of the configuration file
+// When the hash of the configuration file is given the snapshot is matched by the hash instead
+int loadSnapshot(long long modified, unsigned long long size, const unsigned long long *hash, vector<string> &values)
+{
+    SourceFile snapshot;
+    if (!openSource(snapshotFileName, snapshot))
+    {
+        return false;
+    }
+    SnapshotHeader header;
+    int valid = snapshot.size >= sizeof(header);
+    if (valid)
+    {
+        memcpy(&header, snapshot.bytes, sizeof(header));
+        valid = memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 && header.version == SNAPSHOT_VERSION && header.fields == CONFIG_FIELDS;
+        valid = valid && (hash != nullptr ? header.hash == *hash : header.modified == modified && header.size == size);
+    }
+    const char *cursor = snapshot.bytes + sizeof(header), *end = snapshot.bytes + snapshot.size;
+    values.clear();
+    for (int i = 0; valid && i < CONFIG_FIELDS; i++)
+    {
+        values.push_back(readText(cursor, end, valid));
+    }
+    closeSource(snapshot);
+    if (!valid)
+    {
+        values.clear();
+    }
+    return valid;
+}
+
+// Write the values read from the configuration file, with the built in values of its missing fields
+void saveSnapshot(long long modified, unsigned long long size, unsigned long long hash, vector<string> &values)
+{
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.fields = CONFIG_FIELDS;
+    header.modified = modified;
+    header.size = size;
+    header.hash = hash;
+    string bytes((const char *)&header, sizeof(header));
+    for (auto &value : values)
+    {
+        writeText(bytes, value);
+    }
+
+    // A snapshot which already has these contents is left as it is
+    SourceFile snapshot;
+    if (openSource(snapshotFileName, snapshot))
+    {
+        int unchanged = snapshot.size == bytes.size() && memcmp(snapshot.bytes, bytes.data(), bytes.size()) == 0;
+        closeSource(snapshot);
+        if (unchanged)
+        {
+            return;
+        }
+    }
+    replaceFile(snapshotFileName, bytes);
+}
+
+// Parse the configuration file using nolhmann json library and take the value of every field as a text
+// A field which is missing, or is neither a text nor a number, keeps its built in value
+void readConfiguration(string &configurations, vector<string> &values)
+{
+    using json = nlohmann::json;
+    const json config = json::parse(configurations);
+    values.clear();
+    for (auto &field : configFields)
+    {
+        const json *value = &config;
+        for (int i = 0; i < 3 && field.path[i] != nullptr && value != nullptr; i++)
+        {
+            auto member = value->find(field.path[i]);
+            value = member != value->end() ? &*member : nullptr;
+        }
+        if (value != nullptr && value->is_string())
+        {
+            values.push_back(value->get<string>());
+        }
+        else if (value != nullptr && value->is_number())
+        {
+            values.push_back(value->dump());
+        }
+        else
+        {
+            values.push_back(field.value);
+        }
+    }
+}
+
+// Configure the I/O files, keywords, data types, operators, error messages, defaults and optimizations
+void applyConfiguration(vector<string> &values)
+{
+    // Only the configured spellings of keywords and data types are recognized
+    keywords.clear();
+    dataTypes.clear();
+    recognizerBuilt = false;
+    for (int i = 0; i < CONFIG_FIELDS; i++)
+    {
+        const ConfigField &field = configFields[i];
+        string &value = values[i];
+        switch (field.kind)
+        {
+        case KEYWORD_CONFIG:
+            keywords[value] = field.setting;
+            keywordsToString[field.setting] = value;
+            break;
+        case DATATYPE_CONFIG:
+            dataTypes[value] = field.setting;
+            dataTypeToString[field.setting] = value;
+            break;
+        case MATH_CONFIG:
+            mathOperators[value] = field.setting;
+            break;
+        case LOGIC_CONFIG:
+            logicalOperators[value] = field.setting;
+            break;
+        case ERROR_CONFIG:
+            errorMassage[field.setting] = value;
+            break;
+        case OPTION_CONFIG:
+            switch (field.setting)
+            {
+            case INPUT_FILE:
+                inputFileName = value;
+                break;
+            case OUTPUT_FILE:
+                outputFileName = value;
+                break;
+            case ERROR_FILE:
+                errorFileName = value;
+                break;
+            case PREPROCESSED_FILE:
+                preprocessedFileName = value;
+                break;
+            case ARRAY_SIZE:
+                DEFAULT_ARRAY_SIZE = stoi(value);
+                break;
+            case INTEGER_VALUE:
+                DEFAULT_INTEGER_VALUE = stoi(value);
+                break;
+            case REAL_VALUE:
+                DEFAULT_REAL_VALUE = stod(value);
+                break;
+            case TEXT_VALUE:
+                DEFAULT_TEXT_VALUE = value;
+                break;
+            case ARRAY_SEPARATOR_OPTION:
+                ARRAY_SEPARATOR = value;
+                break;
+            case INLINE_SIZE_OPTION:
+                INLINE_SIZE = stoi(value);
+                break;
+            }
+            break;
+        }
+    }
+    openStreams();
 
     // Store the reserved words in a vector to validate the variable names
     reservedWords = {};
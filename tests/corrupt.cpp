@@ -0,0 +1,19 @@
+// Overwrites one byte of a file, the tests use it to break a cache
+// The arguments are the file, the offset of the byte and its new value
+
+#include <fstream>
+#include <string>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    if (argc != 4)
+    {
+        return 1;
+    }
+    fstream file(argv[1], ios::in | ios::out | ios::binary);
+    file.seekp(stol(argv[2]));
+    file.put((char)stoi(argv[3]));
+    return file.good() ? 0 : 1;
+}
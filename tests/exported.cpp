@@ -0,0 +1,43 @@
+// Runs a program with the exported Symboless class, like symls runs it from the command line
+// The input of the program is read from stdin and its output is written to stdout
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "../exports/symls.hpp"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    int engine = symboless::Symboless::INTERPRETER_ENGINE;
+    string fileName = "";
+    for (int i = 1; i < argc; i++)
+    {
+        string argument = argv[i];
+        if (argument.compare("--engine=vm") == 0)
+        {
+            engine = symboless::Symboless::VM_ENGINE;
+        }
+        else
+        {
+            fileName = argument;
+        }
+    }
+
+    ifstream file(fileName);
+    if (!file)
+    {
+        cout << "File not found" << endl;
+        return 1;
+    }
+    stringstream program, input;
+    program << file.rdbuf();
+    input << cin.rdbuf();
+
+    string output;
+    symboless::Symboless symboless(program.str(), input.str(), output, engine);
+    cout << output;
+    return 0;
+}
@@ -0,0 +1,68 @@
+# Runs a program in a directory of its own and compares what it prints with the expected output
+# COMMAND runs PROGRAM with the options in ARGS, INPUT is given to it on stdin and EXPECTED is what it must print
+# CONFIG is copied next to the program, WORK is the directory it runs in
+# CACHE checks the cache of the program, miss compiles it, hit runs it from the cache made by a run before
+# and header or code run it after a byte of the cache made by a run before is broken with CORRUPT
+
+file(REMOVE_RECURSE ${WORK})
+file(MAKE_DIRECTORY ${WORK})
+configure_file(${PROGRAM} ${WORK}/program.symls COPYONLY)
+if(CONFIG)
+    configure_file(${CONFIG} ${WORK}/symlsConfig.json COPYONLY)
+endif()
+separate_arguments(ARGS)
+
+function(run_program)
+    execute_process(COMMAND ${COMMAND} ${ARGS} program.symls
+        WORKING_DIRECTORY ${WORK}
+        INPUT_FILE ${INPUT}
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE errors
+        RESULT_VARIABLE result)
+    file(READ ${EXPECTED} expected)
+    if(NOT result EQUAL 0 OR NOT output STREQUAL expected)
+        message(FATAL_ERROR "Exit code ${result}, printed\n${output}${errors}\ninstead of\n${expected}")
+    endif()
+endfunction()
+
+# A run which preprocesses the program writes processed_program.symls, a run from the cache does not
+function(check_compiled compiled)
+    if(compiled AND NOT EXISTS ${WORK}/processed_program.symls)
+        message(FATAL_ERROR "The program ran from the cache instead of being compiled")
+    elseif(NOT compiled AND EXISTS ${WORK}/processed_program.symls)
+        message(FATAL_ERROR "The program was compiled instead of running from the cache")
+    endif()
+endfunction()
+
+if(NOT CACHE)
+    run_program()
+    return()
+endif()
+
+list(APPEND ARGS --engine=vm --cache --dump-preprocessed)
+if(NOT CACHE STREQUAL "miss")
+    run_program()
+    file(REMOVE ${WORK}/processed_program.symls)
+endif()
+
+# The header ends at byte 56, the offset of the code is at byte 24 and the code starts right after the header
+if(CACHE STREQUAL "header")
+    execute_process(COMMAND ${CORRUPT} ${WORK}/program.symlsc 24 57 RESULT_VARIABLE result)
+elseif(CACHE STREQUAL "code")
+    execute_process(COMMAND ${CORRUPT} ${WORK}/program.symlsc 59 127 RESULT_VARIABLE result)
+endif()
+if(result)
+    message(FATAL_ERROR "The cache could not be broken")
+endif()
+
+run_program()
+if(CACHE STREQUAL "hit")
+    check_compiled(FALSE)
+    return()
+endif()
+check_compiled(TRUE)
+
+# The cache compiled again is used by the next run
+file(REMOVE ${WORK}/processed_program.symls)
+run_program()
+check_compiled(FALSE)